@@ -51,8 +51,24 @@ struct cprop_functor  : public functor_t {
       virtual void lpm_part_select(Design*des, NetPartSelect*obj);
 
       void lpm_compare_eq_(Design*des, const NetCompare*obj);
+      void queue_readers_(Design*des, Nexus*nex);
  };
 
+/*
+ * When the driver of a nexus changes, the nodes that read that nexus
+ * may now be constant propagated, so put them on the work list.
+ */
+void cprop_functor::queue_readers_(Design*des, Nexus*nex)
+{
+      for (Link*cur = nex->first_nlink() ; cur ; cur = cur->next_nlink()) {
+	    if (cur->get_dir() != Link::INPUT)
+		  continue;
+	    NetNode*node = dynamic_cast<NetNode*> (cur->get_obj());
+	    if (node)
+		  des->queue_node(node);
+      }
+}
+
 void cprop_functor::signal(Design*, NetNet*)
 {
 }
@@ -119,11 +135,12 @@ void cprop_functor::lpm_concat(Design*des, NetConcat*obj)
 	// Note that this will leave the const inputs to dangle. They
 	// will be reaped by other passes of cprop_functor.
       delete obj;
+      queue_readers_(des, result_obj->pin(0).nexus());
 
       count += 1;
 }
 
-void cprop_functor::lpm_ff(Design*, NetFF*obj)
+void cprop_functor::lpm_ff(Design*des, NetFF*obj)
 {
 	// Look for and count unlinked FF outputs. Note that if the
 	// Data and Q pins are connected together, they can be removed
@@ -134,9 +151,20 @@ void cprop_functor::lpm_ff(Design*, NetFF*obj)
 	  && (! obj->pin_Sset().is_linked())
 	  && (! obj->pin_Aclr().is_linked())
 	  && (! obj->pin_Aset().is_linked())) {
+	      // The other drivers of the nexus may now be merged
+	      // (see lpm_part_select) so queue them.
+	    vector<NetNode*> others;
+	    Nexus*nex = obj->pin_Q().nexus();
+	    for (Link*cur = nex->first_nlink() ; cur ; cur = cur->next_nlink()) {
+		  NetNode*node = dynamic_cast<NetNode*> (cur->get_obj());
+		  if (node && node != obj)
+			others.push_back(node);
+	    }
 	    obj->pin_Data().unlink();
 	    obj->pin_Q().unlink();
 	    delete obj;
+	    for (size_t idx = 0 ; idx < others.size() ; idx += 1)
+		  des->queue_node(others[idx]);
       }
 }
 
@@ -191,6 +219,7 @@ void cprop_functor::lpm_mux(Design*des, NetMux*obj)
 	    connect(tmp->pin(1), obj->pin_Data(0));
       delete obj;
       des->add_node(tmp);
+      queue_readers_(des, tmp->pin(0).nexus());
       count += 1;
 }
 
@@ -344,6 +373,9 @@ void cprop_functor::lpm_part_select(Design*des, NetPartSelect*obj)
 	    delete obj_set[idx];
       }
 
+	// The new concatenation may have constant inputs.
+      des->queue_node(cncat);
+
       count += 1;
 }
 
@@ -446,17 +478,24 @@ void cprop_dc_functor::lpm_const(Design*, NetConst*obj)
 
 void cprop(Design*des)
 {
-	// Continually propagate constants until a scan finds nothing
-	// to do.
+	// Scan the whole design once. Each optimization puts the nodes
+	// that it may affect on the work list, so after the first scan
+	// only those nodes need to be looked at again.
       cprop_functor prop;
-      do {
-	    prop.count = 0;
-	    des->functor(&prop);
-	    if (verbose_flag) {
-		  cout << " ... Iteration detected "
-		       << prop.count << " optimizations." << endl << flush;
-	    }
-      } while (prop.count > 0);
+      prop.count = 0;
+      des->functor(&prop);
+      if (verbose_flag) {
+	    cout << " ... Scan detected "
+		 << prop.count << " optimizations." << endl << flush;
+      }
+
+      prop.count = 0;
+      unsigned visited = des->functor_queued(&prop);
+      if (verbose_flag) {
+	    cout << " ... Work list visited " << visited << " nodes and"
+		 << " detected " << prop.count << " optimizations."
+		 << endl << flush;
+      }
 
       if (verbose_flag) {
 	    cout << " ... Look for dangling constants" << endl << flush;
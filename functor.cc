@@ -183,6 +183,31 @@ void Design::functor(functor_t*fun)
       }
 }
 
+void Design::queue_node(NetNode*net)
+{
+	/* Only nodes in the design can be tracked through deletes. */
+      if (net->design_ != this)
+	    return;
+      if (node_queued_.insert(net).second)
+	    node_queue_.push_back(net);
+}
+
+unsigned Design::functor_queued(functor_t*fun)
+{
+      unsigned count = 0;
+      while (! node_queue_.empty()) {
+	    NetNode*cur = node_queue_.front();
+	    node_queue_.pop_front();
+
+	      /* Skip nodes that were deleted after they were queued. */
+	    if (node_queued_.erase(cur) == 0)
+		  continue;
+
+	    cur->functor_node(this, fun);
+	    count += 1;
+      }
+      return count;
+}
 
 void NetNode::functor_node(Design*, functor_t*)
 {
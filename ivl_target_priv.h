@@ -22,6 +22,7 @@
 # include  "ivl_target.h"
 # include  <inttypes.h>
 # include  <map>
+# include  <unordered_map>
 # include  <vector>
 # include  <ostream>
 # include  <valarray>
@@ -57,6 +58,12 @@ struct ivl_design_s {
 	// This is used to implement the ivl_design_roots function.
       std::vector<ivl_scope_t> root_scope_list;
 
+	// Map the scopes and signals of the netlist to the objects
+	// that represent them here. These are filled in as the
+	// objects are made so that lookups do not need to search.
+      std::unordered_map<const class NetScope*,ivl_scope_t> scope_map;
+      std::unordered_map<const class NetNet*,ivl_signal_t> signal_map;
+
 	// Keep an array of constants objects.
       std::vector<ivl_net_const_t> consts;
 
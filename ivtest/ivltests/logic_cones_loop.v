@@ -0,0 +1,68 @@
+// Check set/reset latches whose feedback goes through a UDP, which is
+// not gathered into a cone, and through gates only, with logic that
+// is gathered into cones on the latch outputs. This is run with the
+// logic evaluated in cones and with -logic-functor, and the output
+// must be the same.
+primitive udp_nand(o, a, b);
+  output o;
+  input a, b;
+  table
+    0 ? : 1;
+    ? 0 : 1;
+    1 1 : 0;
+  endtable
+endprimitive
+
+module test;
+
+reg s_n, r_n;
+wire q, qb, both, qn, chk;
+wire q2, qb2, both2, chk2;
+
+  // Feedback through the UDP.
+nand     g1(q, s_n, qb);
+udp_nand u1(qb, r_n, q);
+and      g2(both, q, qb);
+not      g3(qn, q);
+xor      g4(chk, qn, qb);
+
+  // Feedback through gates only.
+nand     g5(q2, s_n, qb2);
+nand     g6(qb2, r_n, q2);
+and      g7(both2, q2, qb2);
+xnor     g8(chk2, q2, qb2);
+
+reg failed;
+
+task check(input exp_q, input [8*8:1] step);
+  begin
+    if (q !== exp_q || qb !== !exp_q || both !== 1'b0 || chk !== 1'b0
+        || q2 !== exp_q || qb2 !== !exp_q || both2 !== 1'b0 || chk2 !== 1'b0) begin
+      $display("FAILED -- %0s: q=%b qb=%b both=%b chk=%b q2=%b qb2=%b both2=%b chk2=%b",
+               step, q, qb, both, chk, q2, qb2, both2, chk2);
+      failed = 1;
+    end
+  end
+endtask
+
+integer idx;
+
+initial begin
+  failed = 0;
+  s_n = 1;
+  r_n = 1;
+  for (idx = 0 ; idx < 4 ; idx = idx + 1) begin
+    #1 s_n = 0;
+    #1 check(1, "set");
+    s_n = 1;
+    #1 check(1, "hold 1");
+    r_n = 0;
+    #1 check(0, "reset");
+    r_n = 1;
+    #1 check(0, "hold 0");
+  end
+
+  if (!failed) $display("PASSED");
+end
+
+endmodule
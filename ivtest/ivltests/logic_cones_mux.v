@@ -0,0 +1,45 @@
+// Check the settled values of a chain of muxes, concatenations and
+// part selects. This is run with the logic evaluated in cones and
+// with -logic-functor, and the output must be the same.
+module test;
+
+reg [7:0] a, b;
+reg [1:0] sel;
+
+wire [15:0] c0 = sel[0] ? {a, b} : {b, a};
+wire [15:0] c1 = sel[1] ? {c0[7:0], c0[15:8]} : ~c0;
+wire [7:0]  c2 = c1[11:4];
+wire [23:0] c3 = {c2, c1};
+wire [7:0]  c4 = sel[0] ? c3[23:16] : c3[7:0];
+wire [7:0]  y = c4 ^ c2;
+
+reg [15:0] e0, e1;
+reg [7:0]  e2, e4;
+reg [23:0] e3;
+reg failed;
+integer idx, seed;
+
+initial begin
+  failed = 0;
+  seed = 17;
+  for (idx = 0 ; idx < 200 ; idx = idx + 1) begin
+    a = $random(seed);
+    b = $random(seed);
+    sel = idx;
+    #1 e0 = sel[0] ? {a, b} : {b, a};
+    e1 = sel[1] ? {e0[7:0], e0[15:8]} : ~e0;
+    e2 = e1[11:4];
+    e3 = {e2, e1};
+    e4 = sel[0] ? e3[23:16] : e3[7:0];
+    if (c0 !== e0 || c1 !== e1 || c2 !== e2 || c3 !== e3
+        || c4 !== e4 || y !== (e4 ^ e2)) begin
+      $display("FAILED -- a=%h b=%h sel=%b: c0=%h c1=%h c2=%h c4=%h y=%h",
+               a, b, sel, c0, c1, c2, c4, y);
+      failed = 1;
+    end
+  end
+
+  if (!failed) $display("PASSED");
+end
+
+endmodule
@@ -0,0 +1,51 @@
+// Check the settled values of gate level logic where the fan-out of
+// an input reconverges through paths of different depths. This is
+// run with the logic evaluated in cones and with -logic-functor, and
+// the output must be the same.
+module test;
+
+reg [3:0] in;
+wire na, ba, bba, z0, z1, t1, t2, t3, t4, t5, y;
+wire [3:0] sum = in + 4'd5;
+
+not  n1(na, in[0]);
+buf  b1(ba, in[0]);
+buf  b2(bba, ba);
+xor  x1(z0, na, bba);
+and  a1(z1, in[0], na);
+xor  x2(t1, in[1], in[2]);
+xor  x3(t2, t1, in[3]);
+and  a2(t3, in[1], t2);
+or   o1(t4, t3, t1);
+nand g1(t5, t4, z0, bba);
+xor  x4(y, sum[0], t5);
+
+reg failed;
+reg [3:0] tmp;
+reg e1, e2, e4, e5;
+integer from, to;
+
+initial begin
+  failed = 0;
+  for (from = 0 ; from < 16 ; from = from + 1) begin
+    for (to = 0 ; to < 16 ; to = to + 1) begin
+      in = from;
+      #1 in = to;
+      #1 tmp = in + 4'd5;
+      e1 = in[1] ^ in[2];
+      e2 = e1 ^ in[3];
+      e4 = (in[1] & e2) | e1;
+      e5 = ~(e4 & in[0]);
+      if (z0 !== 1'b1 || z1 !== 1'b0 || t1 !== e1 || t2 !== e2
+          || t4 !== e4 || t5 !== e5 || y !== (tmp[0] ^ e5)) begin
+        $display("FAILED -- %b -> %b: z0=%b z1=%b t1=%b t2=%b t4=%b t5=%b y=%b",
+                 from[3:0], in, z0, z1, t1, t2, t4, t5, y);
+        failed = 1;
+      end
+    end
+  end
+
+  if (!failed) $display("PASSED");
+end
+
+endmodule
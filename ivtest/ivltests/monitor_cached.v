@@ -0,0 +1,30 @@
+// Check that $monitor keeps the text of arguments that did not change,
+// but formats again a bit select with a variable index when only the
+// index changes, and the time when $timeformat changes.
+`timescale 1ns/1ps
+module test;
+
+reg [7:0] bus;
+reg [2:0] i;
+reg [3:0] a;
+
+initial begin
+  $timeformat(-9, 2, " ns", 10);
+  bus = 8'b1010_0110;
+  i = 0;
+  a = 4'h3;
+  $monitor("%t", $time, " a=%h", a, " i=%0d", i, " sel=%b", bus[i],
+           " part=%b", bus[5:4]);
+  #1 i = 1;
+  #1 i = 2;
+  #1 i = 3;
+  #1 a = 4'hc;
+  #1 bus[3] = 1'b1;
+  #1 bus[5:4] = 2'b01;
+  #1 $timeformat(-12, 0, " ps", 12);
+  #1 a = 4'h5;
+  #1 i = 7;
+  #1 i = 6;
+end
+
+endmodule
@@ -0,0 +1,68 @@
+// Check $writememh/$writememb and $readmemh/$readmemb round trips on
+// memories that are larger than one block of words, with descending
+// address ranges, words wider than 32 bits, and x and z digits.
+module test;
+
+localparam N = 10000;
+
+reg [35:0]  fwd  [0:N-1];
+reg [35:0]  fwd2 [0:N-1];
+reg [99:0]  rev  [N-1:0];
+reg [99:0]  rev2 [N-1:0];
+reg [6:0]   bin  [1:N];
+reg [6:0]   bin2 [1:N];
+
+reg failed = 0;
+integer idx;
+
+function [35:0] fval(input integer i);
+  fval = {i[3:0], 32'h0} ^ (i * 32'h9e3779b9);
+endfunction
+
+function [99:0] rval(input integer i);
+  begin
+    rval = {i, i * 7, i * 13, 4'hz};
+    if (i % 5 == 0) rval[17:11] = 7'bx0z1x1z;
+  end
+endfunction
+
+initial begin
+  for (idx = 0 ; idx < N ; idx = idx + 1) begin
+    fwd[idx] = fval(idx);
+    rev[idx] = rval(idx);
+    bin[idx+1] = (idx % 3 == 0) ? 7'b1x0z01x : idx;
+  end
+
+  $writememh("work/readmem_bulk_fwd.dat", fwd);
+  $writememh("work/readmem_bulk_rev.dat", rev, 7000, 20);
+  $writememb("work/readmem_bulk_bin.dat", bin);
+
+  $readmemh("work/readmem_bulk_fwd.dat", fwd2);
+  $readmemh("work/readmem_bulk_rev.dat", rev2, 7000, 20);
+  $readmemb("work/readmem_bulk_bin.dat", bin2);
+
+  for (idx = 0 ; idx < N ; idx = idx + 1) begin
+    if (fwd2[idx] !== fwd[idx]) begin
+      $display("FAILED: fwd2[%0d] = %h, expected %h", idx, fwd2[idx], fwd[idx]);
+      failed = 1;
+    end
+    if (bin2[idx+1] !== bin[idx+1]) begin
+      $display("FAILED: bin2[%0d] = %b, expected %b", idx+1, bin2[idx+1], bin[idx+1]);
+      failed = 1;
+    end
+    if (idx >= 20 && idx <= 7000) begin
+      if (rev2[idx] !== rev[idx]) begin
+	$display("FAILED: rev2[%0d] = %h, expected %h", idx, rev2[idx], rev[idx]);
+	failed = 1;
+      end
+    end else if (rev2[idx] !== 100'bx) begin
+      $display("FAILED: rev2[%0d] = %h, expected x", idx, rev2[idx]);
+      failed = 1;
+    end
+  end
+
+  if (!failed)
+    $display("PASSED");
+end
+
+endmodule
@@ -0,0 +1,62 @@
+// Check the resolution of wide nets with several drivers of
+// different strengths. The nets are wider than a machine word of
+// scalar values so that whole and partial words are both resolved.
+module test;
+
+reg [19:0] a, b, c;
+reg        en;
+
+wire [19:0] w1;
+assign (strong0, strong1) w1 = a;
+assign (weak0, weak1)     w1 = b;
+
+wire [19:0] w2;
+assign (strong0, strong1) w2 = a;
+assign (strong0, strong1) w2 = b;
+
+wire [19:0] w3;
+assign (pull0, pull1)     w3 = a;
+assign (strong0, strong1) w3 = en ? c : 20'bz;
+assign (weak0, weak1)     w3 = b;
+
+wire [19:0] w4;
+assign (strong0, weak1)   w4 = a;
+assign (weak0, strong1)   w4 = b;
+
+reg failed = 0;
+
+task check(input [19:0] got, input [19:0] want, input [63:0] name);
+  if (got !== want) begin
+    $display("FAILED: %0s = %b, expected %b", name, got, want);
+    failed = 1;
+  end
+endtask
+
+initial begin
+  en = 0;
+  a = 20'b0101_0011_zzzz_xx10_1100;
+  b = 20'b1100_zzzz_0101_1x0z_1010;
+  c = 20'b1111_0000_1111_0000_zzzz;
+  #1;
+  // The strong driver always wins, except where it is z.
+  check(w1, 20'b0101_0011_0101_xx10_1100, "w1");
+  // Equal strength drivers make x where the values differ.
+  check(w2, 20'bx10x_0011_0101_xxx0_1xx0, "w2");
+  check(w3, 20'b0101_0011_0101_xx10_1100, "w3");
+  // Strong 0 beats weak 1 and strong 1 beats weak 0, but the two
+  // strong values still make x.
+  check(w4, 20'bx10x_0011_0101_xxx0_1xx0, "w4");
+
+  en = 1;
+  #1;
+  check(w3, 20'b1111_0000_1111_0000_1100, "w3 en");
+
+  b = a;
+  #1;
+  check(w2, a, "w2 same");
+
+  if (!failed)
+    $display("PASSED");
+end
+
+endmodule
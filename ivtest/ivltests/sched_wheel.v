@@ -0,0 +1,49 @@
+// Check that events with many distinct delays, both near to and far
+// from the current time, are run at the right time and in time order.
+module test;
+
+localparam N = 2000;
+
+reg failed = 0;
+time last = 0;
+integer count = 0;
+
+task check(input time expect);
+  begin
+    if ($time !== expect) begin
+      $display("FAILED: woke at %0t, expected %0t", $time, expect);
+      failed = 1;
+    end
+    if ($time < last) begin
+      $display("FAILED: time went back from %0t to %0t", last, $time);
+      failed = 1;
+    end
+    last = $time;
+    count = count + 1;
+  end
+endtask
+
+genvar i;
+for (i = 0 ; i < N ; i = i + 1) begin : gen
+  time start;
+  initial begin
+    start = (i * 37) % 5003 + 1;
+    #((i * 37) % 5003 + 1);
+    check(start);
+    #(1021 + i);
+    check(start + 1021 + i);
+    #0 check(start + 1021 + i);
+  end
+end
+
+initial begin
+  #20000;
+  if (count !== 3*N) begin
+    $display("FAILED: %0d wakeups, expected %0d", count, 3*N);
+    failed = 1;
+  end
+  if (!failed)
+    $display("PASSED");
+end
+
+endmodule
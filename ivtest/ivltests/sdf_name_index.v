@@ -0,0 +1,39 @@
+`celldefine
+module BUF (input A, output Q);
+
+   buf (Q, A);
+
+   specify
+      (A => Q) = (1,1);
+   endspecify
+
+endmodule
+`endcelldefine
+
+module MID (input A, output Q);
+
+   BUF leaf(.A(A), .Q(Q));
+
+endmodule
+
+// The SDF cells are found through the name index of each scope. The
+// first cell has the same name as the scope that holds it, the second
+// has an escaped name and the third is below another instance.
+module tb;
+
+   reg a;
+   wire q1, q2, q3;
+   BUF tb(.A(a), .Q(q1));
+   BUF \cell[1] (.A(a), .Q(q2));
+   MID mid(.A(a), .Q(q3));
+
+   initial begin
+      $monitor($time,, "A=%b, Q=%b%b%b", a, q1, q2, q3);
+      $sdf_annotate("ivltests/sdf_name_index.sdf");
+
+      a = 0;
+      #10 a = 1;
+      #10 $finish(0);
+   end
+
+endmodule // tb
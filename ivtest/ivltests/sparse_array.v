@@ -0,0 +1,55 @@
+// Check that very large memories read back X for words that were never
+// written, and the written value for words that were, both for narrow
+// words and for words wider than a machine word. The memories are big
+// enough to use the sparse array storage in vvp by default, and the test
+// is also run with the sparse storage turned off.
+module test;
+
+reg [7:0]  narrow [0:(1<<21)-1];
+reg [99:0] wide   [0:(1<<21)-1];
+
+reg failed = 0;
+integer idx;
+
+initial begin
+  for (idx = 0 ; idx < 1000 ; idx = idx + 1) begin
+    narrow[idx*idx] = idx;
+    wide[idx*2001] = {idx, 68'h0_1234_5678_9abc_def0} ^ idx;
+  end
+
+  for (idx = 0 ; idx < 1000 ; idx = idx + 1) begin
+    if (narrow[idx*idx] !== idx[7:0]) begin
+      $display("FAILED: narrow[%0d] = %h", idx*idx, narrow[idx*idx]);
+      failed = 1;
+    end
+    if (wide[idx*2001] !== ({idx, 68'h0_1234_5678_9abc_def0} ^ idx)) begin
+      $display("FAILED: wide[%0d] = %h", idx*2001, wide[idx*2001]);
+      failed = 1;
+    end
+    if (idx > 1 && narrow[idx*idx-1] !== 8'bx) begin
+      $display("FAILED: narrow[%0d] = %h", idx*idx-1, narrow[idx*idx-1]);
+      failed = 1;
+    end
+    if (wide[idx*2001+1] !== 100'bx) begin
+      $display("FAILED: wide[%0d] = %h", idx*2001+1, wide[idx*2001+1]);
+      failed = 1;
+    end
+  end
+
+  if (narrow[(1<<21)-1] !== 8'bx || wide[(1<<21)-1] !== 100'bx) begin
+    $display("FAILED: last words are not X");
+    failed = 1;
+  end
+
+  narrow[(1<<21)-1] = 8'h5a;
+  wide[(1<<21)-1] = 100'hz;
+  if (narrow[(1<<21)-1] !== 8'h5a || wide[(1<<21)-1] !== 100'hz) begin
+    $display("FAILED: last words were not written");
+    failed = 1;
+  end
+
+  if (!failed)
+    $display("PASSED");
+end
+
+endmodule
@@ -0,0 +1,69 @@
+// Check a design compiled with -ptwo_state=1. The variables, memories
+// and nets hold two-state values, so they start at 0 and any X or Z
+// bits written into them read back as 0.
+module test;
+
+reg [7:0] r;
+reg signed [7:0] s;
+reg [7:0] mem [0:15];
+wire [7:0] w = r ^ 8'hff;
+wire [3:0] wx = 4'b1x0z;
+integer idx;
+reg [11:0] sum;
+reg failed;
+
+initial begin
+  failed = 0;
+
+  if (r !== 8'h00 || s !== 8'sh00 || mem[3] !== 8'h00) begin
+    $display("FAILED -- initial values r=%b s=%b mem[3]=%b", r, s, mem[3]);
+    failed = 1;
+  end
+
+  r = 8'bx1z0_1010;
+  s = 8'b1x0z_0001;
+  mem[5] = 8'bzzzz_1x01;
+  #1;
+  if (r !== 8'b0100_1010) begin
+    $display("FAILED -- r=%b", r);
+    failed = 1;
+  end
+  if (s !== -8'sd127) begin
+    $display("FAILED -- s=%b", s);
+    failed = 1;
+  end
+  if (mem[5] !== 8'h09 || mem[4] !== 8'h00) begin
+    $display("FAILED -- mem[5]=%b mem[4]=%b", mem[5], mem[4]);
+    failed = 1;
+  end
+  if (w !== 8'hb5) begin
+    $display("FAILED -- w=%b", w);
+    failed = 1;
+  end
+  if (wx !== 4'b1000) begin
+    $display("FAILED -- wx=%b", wx);
+    failed = 1;
+  end
+
+  r = r + 8'bx;
+  #1;
+  if (r !== 8'h00 || w !== 8'hff) begin
+    $display("FAILED -- r=%b w=%b after adding X", r, w);
+    failed = 1;
+  end
+
+  for (idx = 0 ; idx < 16 ; idx = idx + 1)
+    mem[idx] = idx * 3;
+  mem[7] = 8'hxx;
+  sum = 0;
+  for (idx = 0 ; idx < 16 ; idx = idx + 1)
+    sum = sum + mem[idx];
+  if (sum !== 12'd339) begin
+    $display("FAILED -- memory sum=%0d", sum);
+    failed = 1;
+  end
+
+  if (!failed) $display("PASSED");
+end
+
+endmodule
@@ -0,0 +1,8 @@
+// A gate that can drive Z is an error in two-state mode.
+module test;
+
+reg in, en;
+wire out;
+bufif1 b1(out, in, en);
+
+endmodule
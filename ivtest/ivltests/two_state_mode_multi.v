@@ -0,0 +1,9 @@
+// A net with more than one driver is an error in two-state mode.
+module test;
+
+reg a, b;
+wire w;
+and g1(w, a, b);
+or  g2(w, a, b);
+
+endmodule
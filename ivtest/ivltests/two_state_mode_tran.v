@@ -0,0 +1,7 @@
+// A tran switch is an error in two-state mode.
+module test;
+
+wire a, b;
+tran t1(a, b);
+
+endmodule
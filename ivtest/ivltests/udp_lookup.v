@@ -0,0 +1,111 @@
+// Check small combinational and sequential UDPs for every input
+// value, so that the precomputed lookup tables give the same results
+// as the table rows.
+primitive mux2 (y, s, a, b);
+  output y;
+  input s, a, b;
+  table
+  // s a b : y
+     0 0 ? : 0;
+     0 1 ? : 1;
+     1 ? 0 : 0;
+     1 ? 1 : 1;
+     x 0 0 : 0;
+     x 1 1 : 1;
+  endtable
+endprimitive
+
+primitive dff_r (q, clk, d, rn);
+  output q;
+  reg q;
+  input clk, d, rn;
+  table
+  // clk d rn : q : q+
+     ?   ?  0 : ? : 0;
+     r   0  1 : ? : 0;
+     r   1  1 : ? : 1;
+     f   ?  1 : ? : -;
+     ?   *  1 : ? : -;
+     ?   ?  r : ? : -;
+  endtable
+endprimitive
+
+module test;
+
+reg s, a, b;
+wire y;
+mux2 m (y, s, a, b);
+
+reg clk, d, rn;
+wire q;
+dff_r f (q, clk, d, rn);
+
+reg q_model;
+reg failed = 0;
+integer idx, seed;
+
+function [0:0] val4(input integer val);
+  case (val % 4)
+    0: val4 = 1'b0;
+    1: val4 = 1'b1;
+    2: val4 = 1'bx;
+    default: val4 = 1'bz;
+  endcase
+endfunction
+
+function [0:0] mux_model(input s, a, b);
+  if (s === 1'b0)
+    mux_model = (a === 1'b0 || a === 1'b1) ? a : 1'bx;
+  else if (s === 1'b1)
+    mux_model = (b === 1'b0 || b === 1'b1) ? b : 1'bx;
+  else if (a === b && (a === 1'b0 || a === 1'b1))
+    mux_model = a;
+  else
+    mux_model = 1'bx;
+endfunction
+
+initial begin
+  for (idx = 0 ; idx < 64 ; idx = idx + 1) begin
+    s = val4(idx);
+    a = val4(idx/4);
+    b = val4(idx/16);
+    #1;
+    if (y !== mux_model(s, a, b)) begin
+      $display("FAILED: mux2(%b, %b, %b) = %b", s, a, b, y);
+      failed = 1;
+    end
+  end
+
+  // Drive the flip-flop with clean 0/1 values and compare with a
+  // behavioral model.
+  seed = 1;
+  clk = 0;
+  d = 0;
+  rn = 0;
+  q_model = 0;
+  #1;
+  for (idx = 0 ; idx < 400 ; idx = idx + 1) begin
+    case ($random(seed) & 3)
+      0: begin
+        clk = ~clk;
+        if (clk && rn)
+          q_model = d;
+      end
+      1: d = ~d;
+      2: if (($random(seed) & 7) == 0) rn = ~rn;
+      3: ;
+    endcase
+    if (!rn)
+      q_model = 0;
+    #1;
+    if (q !== q_model) begin
+      $display("FAILED: step %0d: q = %b, expected %b", idx, q, q_model);
+      failed = 1;
+    end
+  end
+
+  if (!failed)
+    $display("PASSED");
+end
+
+endmodule
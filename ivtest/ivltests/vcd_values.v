@@ -0,0 +1,36 @@
+// Check the VCD text for x and z bits, vectors that are wider than 64
+// bits, the truncation of leading bits and values written through part
+// selects. The dump file limit is set so that it is exceeded at the
+// tenth toggle of s. This is run with and without -vcd-parallel, and
+// the dump file is compared with the same gold file.
+`timescale 1ns/1ns
+module test;
+
+reg  [3:0] n;
+reg        s;
+reg [98:0] wide;
+
+initial begin
+  $dumpfile("work/vcd_values.vcd");
+  $dumplimit(878);
+  $dumpvars(0, test);
+  #1 s = 1'b0;
+  #1 n = 4'b0010;
+  #1 n = 4'b00z1;
+  #1 n = 4'bxx01;
+  #1 n = 4'bzzzz;
+  #1 wide = 99'h1;
+  #1 wide = {3'b101, 96'h0};
+  #1 wide[70:67] = 4'bx1z0;
+  #1 wide[98:96] = 3'b000;
+  #1 wide[64:63] = 2'b1z;
+  #1 begin
+    n = 4'b1111;
+    s = 1'b1;
+    wide = {99{1'bx}};
+  end
+  #1 wide = {1'b0, {98{1'bz}}};
+  repeat (40) #1 s = ~s;
+end
+
+endmodule
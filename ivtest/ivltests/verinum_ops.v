@@ -0,0 +1,228 @@
+// Check the compile time arithmetic on constant values. The operators
+// work a machine word at a time, so the tests use widths below, at and
+// past the 64 bit word size, and operands with x and z bits. Each
+// operator is folded at compile time into a localparam and compared
+// with the same operator worked out by the run time on variables.
+
+`define check(name, val, exp) \
+    if ((val) !== (exp)) begin \
+      $display("FAILED(%m) %s: got %h, expected %h", name, val, exp); \
+      failed = 1'b1; \
+    end
+
+module ops_u #(parameter W = 8,
+               parameter [W-1:0] A = 0,
+               parameter [W-1:0] B = 0,
+               parameter SH = 0);
+
+localparam [W-1:0] ADD  = A + B;
+localparam [W-1:0] SUB  = A - B;
+localparam [W-1:0] NEG  = -A;
+localparam [W-1:0] MUL  = A * B;
+localparam [W-1:0] DIV  = A / B;
+localparam [W-1:0] MOD  = A % B;
+localparam [W-1:0] POW  = A ** 3;
+localparam [W-1:0] INV  = ~A;
+localparam [W-1:0] SHL  = A << SH;
+localparam [W-1:0] SHR  = A >> SH;
+localparam [W-1:0] ASR  = A >>> SH;
+localparam LT  = A < B;
+localparam LE  = A <= B;
+localparam GT  = A > B;
+localparam GE  = A >= B;
+localparam EQ  = A == B;
+localparam NE  = A != B;
+localparam CEQ = A === B;
+localparam [2*W-1:0] CAT   = {A, B};
+localparam [3*W-1:0] REP   = {3{A}};
+localparam [2*W-1:0] ZEXT  = A;
+localparam [W-1:0]   TRUNC = {B, A} >> 1;
+
+reg [W-1:0] a, b;
+reg [2*W-1:0] zext;
+reg [W-1:0] trunc;
+integer sh;
+reg failed;
+
+initial begin
+  failed = 1'b0;
+  a = A;
+  b = B;
+  sh = SH;
+  zext = a;
+  trunc = {b, a} >> 1;
+  `check("+", a + b, ADD)
+  `check("-", a - b, SUB)
+  `check("unary -", -a, NEG)
+  `check("*", a * b, MUL)
+  `check("/", a / b, DIV)
+  `check("%", a % b, MOD)
+  `check("**", a ** 3, POW)
+  `check("~", ~a, INV)
+  `check("<<", a << sh, SHL)
+  `check(">>", a >> sh, SHR)
+  `check(">>>", a >>> sh, ASR)
+  `check("<", a < b, LT)
+  `check("<=", a <= b, LE)
+  `check(">", a > b, GT)
+  `check(">=", a >= b, GE)
+  `check("==", a == b, EQ)
+  `check("!=", a != b, NE)
+  `check("===", a === b, CEQ)
+  `check("concat", {a, b}, CAT)
+  `check("replicate", {3{a}}, REP)
+  `check("zero extend", zext, ZEXT)
+  `check("truncate", trunc, TRUNC)
+end
+
+endmodule
+
+module ops_s #(parameter W = 8,
+               parameter signed [W-1:0] A = 0,
+               parameter signed [W-1:0] B = 0,
+               parameter SH = 0);
+
+localparam signed [W-1:0] ADD  = A + B;
+localparam signed [W-1:0] SUB  = A - B;
+localparam signed [W-1:0] NEG  = -A;
+localparam signed [W-1:0] MUL  = A * B;
+localparam signed [W-1:0] DIV  = A / B;
+localparam signed [W-1:0] MOD  = A % B;
+localparam signed [W-1:0] POW  = A ** 3;
+localparam signed [W-1:0] INV  = ~A;
+localparam signed [W-1:0] SHL  = A << SH;
+localparam signed [W-1:0] SHR  = A >> SH;
+localparam signed [W-1:0] ASR  = A >>> SH;
+localparam LT  = A < B;
+localparam LE  = A <= B;
+localparam GT  = A > B;
+localparam GE  = A >= B;
+localparam EQ  = A == B;
+localparam NE  = A != B;
+localparam signed [2*W-1:0] SEXT = A;
+localparam signed [W-1:0]   TRUNC = {B, A} >> 1;
+
+reg signed [W-1:0] a, b;
+reg signed [2*W-1:0] sext;
+reg signed [W-1:0] trunc;
+integer sh;
+reg failed;
+
+initial begin
+  failed = 1'b0;
+  a = A;
+  b = B;
+  sh = SH;
+  sext = a;
+  trunc = {b, a} >> 1;
+  `check("+", a + b, ADD)
+  `check("-", a - b, SUB)
+  `check("unary -", -a, NEG)
+  `check("*", a * b, MUL)
+  `check("/", a / b, DIV)
+  `check("%", a % b, MOD)
+  `check("**", a ** 3, POW)
+  `check("~", ~a, INV)
+  `check("<<", a << sh, SHL)
+  `check(">>", a >> sh, SHR)
+  `check(">>>", a >>> sh, ASR)
+  `check("<", a < b, LT)
+  `check("<=", a <= b, LE)
+  `check(">", a > b, GT)
+  `check(">=", a >= b, GE)
+  `check("==", a == b, EQ)
+  `check("!=", a != b, NE)
+  `check("sign extend", sext, SEXT)
+  `check("truncate", trunc, TRUNC)
+end
+
+endmodule
+
+// Values worked out by hand, for carries and shifts that cross a word
+// boundary, x and z bits, and unsized operands that are trimmed.
+module fixed;
+
+localparam [127:0] CARRY  = 128'h0000_0000_0000_0000_ffff_ffff_ffff_ffff + 128'h1;
+localparam [127:0] BORROW = 128'h0000_0000_0000_0001_0000_0000_0000_0000 - 128'h1;
+localparam [127:0] SQUARE = 128'hffff_ffff_ffff_ffff * 128'hffff_ffff_ffff_ffff;
+localparam [127:0] POW2   = 128'd2 ** 100;
+localparam [127:0] POW3   = 128'd3 ** 40;
+localparam [127:0] SHL64  = 128'h1 << 64;
+localparam [64:0]  SHR1   = 65'h1_0000_0000_0000_0000 >> 1;
+localparam signed [64:0] ASR64 = 65'sh1_0000_0000_0000_0000 >>> 64;
+localparam signed [127:0] SEXT = 64'sh8000_0000_0000_0000;
+localparam GT65  = 65'h1_0000_0000_0000_0000 > 65'h0_ffff_ffff_ffff_ffff;
+localparam SLT65 = 65'sh1_0000_0000_0000_0000 < 65'sh0;
+localparam [64:0]  INV65  = ~65'h0;
+localparam [127:0] ADDX   = 128'h1x + 128'h1;
+localparam [64:0]  SHLZ   = 65'bz << 64;
+localparam LTX = 128'hx < 128'h1;
+localparam [64:0]  INVZ   = ~65'h0_ffff_ffff_ffff_fffz;
+localparam [129:0] CATW   = {65'h1_0000_0000_0000_0001, 65'h1_ffff_ffff_ffff_fffe};
+localparam [127:0] TRIM1  = 100000 * 100000;
+localparam [127:0] TRIM2  = -1 * 3;
+localparam [127:0] TRIM3  = 1 << 70;
+
+reg failed;
+
+initial begin
+  failed = 1'b0;
+  `check("carry", CARRY, 128'h0000_0000_0000_0001_0000_0000_0000_0000)
+  `check("borrow", BORROW, 128'h0000_0000_0000_0000_ffff_ffff_ffff_ffff)
+  `check("square", SQUARE, 128'hffff_ffff_ffff_fffe_0000_0000_0000_0001)
+  `check("2**100", POW2, 128'h0000_0010_0000_0000_0000_0000_0000_0000)
+  `check("3**40", POW3, 128'h0000_0000_0000_0000_a8b8_b452_291f_e821)
+  `check("<< 64", SHL64, 128'h0000_0000_0000_0001_0000_0000_0000_0000)
+  `check(">> 1", SHR1, 65'h0_8000_0000_0000_0000)
+  `check(">>> 64", ASR64, 65'h1_ffff_ffff_ffff_ffff)
+  `check("sign extend", SEXT, 128'hffff_ffff_ffff_ffff_8000_0000_0000_0000)
+  `check("> 65", GT65, 1'b1)
+  `check("signed < 65", SLT65, 1'b1)
+  `check("~ 65", INV65, 65'h1_ffff_ffff_ffff_ffff)
+  `check("x +", ADDX, 128'hx)
+  `check("z <<", SHLZ, {1'bz, 64'h0})
+  `check("x <", LTX, 1'bx)
+  `check("~ z", INVZ, {1'b1, 60'h0, 4'bxxxx})
+  `check("concat", CATW, 130'h2_0000_0000_0000_0003_ffff_ffff_ffff_fffe)
+  `check("unsized *", TRIM1, 128'd10000000000)
+  `check("unsized negative", TRIM2, 128'hffff_ffff_ffff_ffff_ffff_ffff_ffff_fffd)
+  `check("unsized <<", TRIM3, 128'h0000_0000_0000_0040_0000_0000_0000_0000)
+end
+
+endmodule
+
+module test;
+
+ops_u #(1, 1'b1, 1'b1, 0) u1();
+ops_u #(8, 8'hb7, 8'h5c, 3) u8();
+ops_u #(8, 8'b1x0z_0101, 8'h0f, 2) u8x();
+ops_u #(32, 32'hdead_beef, 32'h1234_5678, 31) u32();
+ops_u #(63, 63'h7fff_ffff_ffff_ffff, 63'h1, 62) u63();
+ops_u #(64, 64'hffff_ffff_ffff_ffff, 64'hffff_ffff_0000_0001, 64) u64();
+ops_u #(65, 65'h1_8000_0000_0000_0001, 65'h0_ffff_ffff_ffff_ffff, 1) u65();
+ops_u #(100, 100'h1_2345_6789_abcd_ef01_2345_6789,
+             100'hf_edcb_a987_6543_210f_edcb_a987, 36) u100();
+ops_u #(128, 128'hffff_ffff_ffff_ffff_ffff_ffff_ffff_ffff, 128'h1, 100) u128();
+ops_u #(129, 129'h1_0000_0000_0000_000z_ffff_ffff_ffff_ffff,
+             129'h0_8000_0000_0000_0000_0000_0000_0000_0001, 65) u129x();
+
+ops_s #(8, -8'sd73, 8'sh5c, 3) s8();
+ops_s #(33, 33'sh1_xxxx_0000, -33'sd5, 4) s33x();
+ops_s #(64, 64'sh8000_0000_0000_0000, -64'sd3, 63) s64();
+ops_s #(65, 65'sh1_0000_0000_0000_0000, 65'sh0_ffff_ffff_ffff_ffff, 64) s65();
+ops_s #(128, -128'sd3, 128'sd5, 127) s128();
+
+fixed f();
+
+initial begin
+  #1;
+  if (u1.failed || u8.failed || u8x.failed || u32.failed || u63.failed
+      || u64.failed || u65.failed || u100.failed || u128.failed
+      || u129x.failed || s8.failed || s33x.failed || s64.failed
+      || s65.failed || s128.failed || f.failed)
+    $display("FAILED");
+  else
+    $display("PASSED");
+end
+
+endmodule
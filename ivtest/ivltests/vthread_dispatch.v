@@ -0,0 +1,50 @@
+// Check the common thread instructions (loads, stores, compares,
+// conditional jumps and arithmetic), including the x and z cases.
+module test;
+
+reg [7:0] count;
+reg [63:0] acc;
+reg [3:0] xv;
+integer i;
+reg failed = 0;
+
+initial begin
+  count = 0;
+  acc = 0;
+  for (i = 0 ; i < 100 ; i = i + 1) begin
+    count = count + 1;
+    acc = acc + i * 3 - 1;
+    if (count == 50)
+      acc = acc ^ 64'hffff;
+  end
+  if (count !== 8'd100) begin
+    $display("FAILED: count = %d", count);
+    failed = 1;
+  end
+  if (acc !== 64'd73035) begin
+    $display("FAILED: acc = %d", acc);
+    failed = 1;
+  end
+
+  xv = 4'b1x0z;
+  if (xv == 4'b1x0z) begin
+    $display("FAILED: x compare is true");
+    failed = 1;
+  end
+  if (xv === 4'b1x0z) begin
+  end else begin
+    $display("FAILED: case compare is false");
+    failed = 1;
+  end
+  if (!(xv != 4'b0000)) begin
+    $display("FAILED: not equal is false");
+    failed = 1;
+  end
+  while (xv !== 4'b0000)
+    xv = {xv[2:0], 1'b0};
+
+  if (!failed)
+    $display("PASSED");
+end
+
+endmodule
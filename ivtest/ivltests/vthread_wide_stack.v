@@ -0,0 +1,94 @@
+// Check wide vector arithmetic and logic on the thread stack. The
+// stack entries are reused by later pushes, so mix the widths of the
+// values to make sure that no bits leak from one value to the next.
+module test;
+
+reg [255:0] a, b, c;
+reg [189:0] w190;
+reg [149:0] w150;
+reg [7:0]   n;
+reg [255:0] sum;
+integer idx;
+reg failed = 0;
+
+initial begin
+  a = {4{64'h0123_4567_89ab_cdef}};
+  b = {4{64'hfedc_ba98_7654_3210}};
+
+  c = a + b;
+  if (c !== {256{1'b1}}) begin
+    $display("FAILED: a + b = %h", c);
+    failed = 1;
+  end
+
+  c = (a + b) - b;
+  if (c !== a) begin
+    $display("FAILED: (a + b) - b = %h", c);
+    failed = 1;
+  end
+
+  c = (a ^ b) ^ b;
+  if (c !== a) begin
+    $display("FAILED: (a ^ b) ^ b = %h", c);
+    failed = 1;
+  end
+
+  c = (a & b) | (a & ~b);
+  if (c !== a) begin
+    $display("FAILED: (a & b) | (a & ~b) = %h", c);
+    failed = 1;
+  end
+
+  c = a * 256'd16;
+  if (c !== {a[251:0], 4'h0}) begin
+    $display("FAILED: a * 16 = %h", c);
+    failed = 1;
+  end
+
+  // Alternate values of different widths through the same stack
+  // entries.
+  w190 = {190{1'b1}};
+  w150 = 150'd5;
+  n = 8'd3;
+  for (idx = 0 ; idx < 10 ; idx = idx + 1) begin
+    if (w190 + 190'd1 !== 190'd0) begin
+      $display("FAILED: w190 + 1 = %h", w190 + 190'd1);
+      failed = 1;
+    end
+    if (w150 + 150'd1 !== 150'd6) begin
+      $display("FAILED: w150 + 1 = %h", w150 + 150'd1);
+      failed = 1;
+    end
+    if (n + 8'd1 !== 8'd4) begin
+      $display("FAILED: n + 1 = %h", n + 8'd1);
+      failed = 1;
+    end
+  end
+
+  // Values with x bits must still be x after the stack is reused.
+  c = a;
+  c[200] = 1'bx;
+  if ((c + b) !== {256{1'bx}}) begin
+    $display("FAILED: c + b = %h", c + b);
+    failed = 1;
+  end
+  if ((a + b) !== {256{1'b1}}) begin
+    $display("FAILED: a + b after x = %h", a + b);
+    failed = 1;
+  end
+
+  // Accumulate in a loop so that the same stack entries are used
+  // over and over again.
+  sum = 0;
+  for (idx = 0 ; idx < 100 ; idx = idx + 1)
+    sum = sum + a;
+  if (sum !== a * 256'd100) begin
+    $display("FAILED: sum = %h", sum);
+    failed = 1;
+  end
+
+  if (!failed)
+    $display("PASSED");
+end
+
+endmodule
@@ -0,0 +1,81 @@
+// Check the instruction sequences that vvp fuses into single
+// instructions: load/compare with an immediate, and load/add/store
+// and load/subtract/store of a variable.
+module test;
+
+reg [7:0] up, down;
+reg [3:0] xv;
+reg [95:0] wide;
+integer hits;
+reg failed = 0;
+
+task automatic count_auto(input integer n, output integer res);
+  integer cnt;
+  begin
+    cnt = 0;
+    while (cnt != n)
+      cnt = cnt + 1;
+    res = cnt;
+  end
+endtask
+
+initial begin
+  up = 0;
+  down = 8'd200;
+  hits = 0;
+  while (up != 8'd100) begin
+    up = up + 1;
+    down = down - 1;
+    if (up == 8'd50)
+      hits = hits + 1;
+  end
+  if (up !== 8'd100 || down !== 8'd100 || hits !== 1) begin
+    $display("FAILED: up=%0d down=%0d hits=%0d", up, down, hits);
+    failed = 1;
+  end
+
+  up = 8'd255;
+  up = up + 1;
+  if (up !== 8'd0) begin
+    $display("FAILED: up wrapped to %0d", up);
+    failed = 1;
+  end
+
+  wide = {64'd0, 32'hffffffff};
+  wide = wide + 1;
+  if (wide !== {63'd0, 1'b1, 32'd0}) begin
+    $display("FAILED: wide = %h", wide);
+    failed = 1;
+  end
+
+  xv = 4'b10x1;
+  if (xv == 4'b1001) begin
+    $display("FAILED: x compare is true");
+    failed = 1;
+  end
+  if (xv != 4'b1001) begin
+    $display("FAILED: x not-equal compare is true");
+    failed = 1;
+  end
+  if (xv == 4'b0001) ; else hits = hits + 1;
+  xv = xv + 1;
+  if (xv !== 4'bxxxx) begin
+    $display("FAILED: x increment = %b", xv);
+    failed = 1;
+  end
+  if (hits !== 2) begin
+    $display("FAILED: hits=%0d", hits);
+    failed = 1;
+  end
+
+  count_auto(37, hits);
+  if (hits !== 37) begin
+    $display("FAILED: automatic count = %0d", hits);
+    failed = 1;
+  end
+
+  if (!failed)
+    $display("PASSED");
+end
+
+endmodule
@@ -0,0 +1,117 @@
+// Combinational logic benchmark: a 32-bit ALU written out as gates, the
+// way a synthesis tool would produce it. It has a ripple carry adder
+// (also used to subtract), bitwise AND, OR and XOR, a gate level output
+// multiplexer and a zero flag. A change of the inputs ripples through
+// many levels of zero delay gates, so this measures how combinational
+// logic is evaluated. Compare the run time and event counts that vvp -v
+// prints with and without the -logic-functor extended argument.
+module alu_bit(output s, co, o_and, o_or, o_xor, input a, b, sub, ci);
+  wire bx, p, g, t;
+  xor (bx, b, sub);
+  xor (p, a, bx);
+  xor (s, p, ci);
+  and (g, a, bx);
+  and (t, p, ci);
+  or  (co, g, t);
+  and (o_and, a, b);
+  or  (o_or, a, b);
+  xor (o_xor, a, b);
+endmodule
+
+// Select one of four inputs with a one-hot select.
+module alu_mux(output y, input [3:0] d, input [3:0] sel);
+  wire [3:0] m;
+  and (m[0], d[0], sel[0]);
+  and (m[1], d[1], sel[1]);
+  and (m[2], d[2], sel[2]);
+  and (m[3], d[3], sel[3]);
+  or  (y, m[0], m[1], m[2], m[3]);
+endmodule
+
+module alu(output [31:0] y, output zero, input [31:0] a, b, input [2:0] op);
+  wire [32:0] c;
+  wire [31:0] s, o_and, o_or, o_xor;
+  wire [3:0] sel;
+  wire nop1, nop2;
+
+  // op: 0 add, 1 sub, 2 and, 3 or, 4 xor
+  not (nop1, op[1]);
+  not (nop2, op[2]);
+  and (sel[0], nop2, nop1);
+  and (sel[1], nop2, op[1], ~op[0]);
+  and (sel[2], nop2, op[1], op[0]);
+  buf (sel[3], op[2]);
+
+  assign c[0] = op[0] & ~op[1] & ~op[2];
+
+  genvar i;
+  generate
+    for (i = 0 ; i < 32 ; i = i + 1) begin : bits
+      alu_bit u (s[i], c[i+1], o_and[i], o_or[i], o_xor[i],
+                 a[i], b[i], c[0], c[i]);
+      alu_mux m (y[i], {o_xor[i], o_or[i], o_and[i], s[i]}, sel);
+    end
+  endgenerate
+
+  nor (zero, y[0], y[1], y[2], y[3], y[4], y[5], y[6], y[7],
+       y[8], y[9], y[10], y[11], y[12], y[13], y[14], y[15],
+       y[16], y[17], y[18], y[19], y[20], y[21], y[22], y[23],
+       y[24], y[25], y[26], y[27], y[28], y[29], y[30], y[31]);
+endmodule
+
+module bench;
+
+localparam UNITS = 64;
+localparam CYCLES = 20000;
+
+reg [31:0] a, b;
+reg [2:0] op;
+wire [32*UNITS-1:0] y;
+wire [UNITS-1:0] zero;
+
+genvar u;
+generate
+  for (u = 0 ; u < UNITS ; u = u + 1) begin : units
+    alu dut (y[u*32 +: 32], zero[u], a ^ u, b, op);
+  end
+endgenerate
+
+function [31:0] model(input [31:0] a, b, input [2:0] op);
+  case (op)
+    0: model = a + b;
+    1: model = a - b;
+    2: model = a & b;
+    3: model = a | b;
+    default: model = a ^ b;
+  endcase
+endfunction
+
+integer i, k, errors;
+reg [31:0] seed;
+
+initial begin
+  errors = 0;
+  seed = 1;
+  for (i = 0 ; i < CYCLES ; i = i + 1) begin
+    seed = seed * 1664525 + 1013904223;
+    a = seed;
+    seed = seed * 1664525 + 1013904223;
+    b = (i % 7 == 0) ? a : seed;
+    op = i % 5;
+    #1;
+    for (k = 0 ; k < UNITS ; k = k + 8) begin
+      if (y[k*32 +: 32] !== model(a ^ k, b, op)
+          || zero[k] !== (y[k*32 +: 32] == 0)) begin
+        if (errors < 10)
+          $display("FAILED -- unit %0d: %h op %0d %h = %h", k, a ^ k,
+                   op, b, y[k*32 +: 32]);
+        errors = errors + 1;
+      end
+    end
+  end
+  if (errors == 0)
+    $display("PASSED");
+  $finish;
+end
+
+endmodule
@@ -0,0 +1,39 @@
+// Constant evaluation benchmark: a constant function that mixes wide
+// vectors with add, subtract, multiply, shift and compare operations,
+// and which is used to compute parameters at elaboration time. This
+// measures the compiler rather than vvp. Compile it with "iverilog -v"
+// and compare the elaboration time that the compiler prints. The same
+// function is called again at run time to check the constant result.
+module bench;
+
+localparam ROUNDS = 20000;
+
+function [255:0] mix(input [255:0] seed, input integer rounds);
+  reg [255:0] acc;
+  reg [255:0] tmp;
+  integer i;
+  begin
+    acc = seed;
+    for (i = 0 ; i < rounds ; i = i + 1) begin
+      tmp = (acc << 13) ^ (acc >> 7);
+      acc = acc * 256'd6364136223846793005 + tmp - i;
+      if (acc < tmp)
+        acc = acc + 256'd1442695040888963407;
+    end
+    mix = acc;
+  end
+endfunction
+
+localparam [255:0] P0 = mix(256'd1, ROUNDS);
+localparam [255:0] P1 = mix(P0, ROUNDS);
+localparam [255:0] P2 = mix(P1, ROUNDS);
+localparam [255:0] P3 = mix(P2, ROUNDS);
+
+initial begin
+  if (P3 !== mix(mix(mix(mix(256'd1, ROUNDS), ROUNDS), ROUNDS), ROUNDS))
+    $display("FAILED -- P3 = %h", P3);
+  else
+    $display("PASSED");
+end
+
+endmodule
@@ -0,0 +1,46 @@
+// Waveform dump benchmark: a bank of counters of different widths
+// that all change every clock, with everything dumped. Run it with
+// and without +nodump to see the cost of dumping, and with
+// -vcd/-fst/-lxt2 to compare the dumpers. With -fst, compare the wall
+// time (e.g. with time(1)) with and without -fst-parallel. With -vcd,
+// divide the size of dump_vcd.vcd by the wall time to get the output
+// rate in MB/s, and compare it with and without -vcd-parallel.
+module bench;
+
+localparam COUNTERS = 256;
+
+reg clk = 0;
+
+genvar g;
+generate
+  for (g = 0 ; g < COUNTERS ; g = g + 1) begin : cnt
+    localparam [31:0] G = g;
+    reg [7:0]   n8;
+    reg [31:0]  n32;
+    reg [127:0] n128;
+    initial begin
+      n8 = g;
+      n32 = g * 32'h01000193;
+      n128 = {4{n32}};
+    end
+    always @(posedge clk) begin
+      n8 <= n8 + 1;
+      n32 <= n32 ^ (n32 << 1) ^ g;
+      n128 <= n128 + {G, 96'd1};
+    end
+  end
+endgenerate
+
+always #5 clk = ~clk;
+
+initial begin
+  if (!$test$plusargs("nodump")) begin
+    $dumpfile("dump_vcd.vcd");
+    $dumpvars(0, bench);
+  end
+  #100000;
+  $display("PASSED");
+  $finish;
+end
+
+endmodule
@@ -0,0 +1,39 @@
+// Elaboration benchmark: one clock net and one enable net that fan out
+// to 100000 flip-flop instances. This measures the compiler rather than
+// vvp. Compile it with "iverilog -v" and compare the elaboration and
+// functor times that the compiler prints.
+module dff(input wire clk, input wire en, output reg q);
+
+initial q = 1'b0;
+
+always @(posedge clk)
+  if (en) q <= ~q;
+
+endmodule
+
+module bench;
+
+localparam FANOUT = 100000;
+
+reg clk = 0;
+reg en = 1;
+wire [FANOUT-1:0] q;
+
+genvar g;
+generate
+  for (g = 0 ; g < FANOUT ; g = g + 1) begin : cell
+    dff u (.clk(clk), .en(en), .q(q[g]));
+  end
+endgenerate
+
+initial begin
+  #1 clk = 1;
+  #1 clk = 0;
+  #1 if (&q === 1'b1)
+    $display("PASSED");
+  else
+    $display("FAILED");
+  $finish;
+end
+
+endmodule
@@ -0,0 +1,61 @@
+// Net propagation benchmark: a large gate-level netlist in which every
+// gate output fans out to gates spread over the whole design, so that
+// a value change walks fan-out chains whose nets are far apart in
+// memory. The netlist is a stack of LEVELS rows of WIDTH gates, each
+// gate taking three inputs from pseudo-randomly chosen gates of the
+// row above. It is too big for the CPU caches, so this measures the
+// cost of cache misses in net propagation. Compare the run time that
+// vvp -v prints.
+module bench;
+
+localparam WIDTH = 16384;
+localparam LEVELS = 12;
+localparam CYCLES = 2000;
+
+reg [WIDTH-1:0] in;
+wire [WIDTH*(LEVELS+1)-1:0] row;
+
+assign row[WIDTH-1:0] = in;
+
+// A multiplicative hash that spreads the inputs of a row of gates
+// over the whole row above.
+function integer pick(input integer idx, input integer salt);
+  pick = ((idx + salt) * 40503 + salt * 2654435) % WIDTH;
+endfunction
+
+genvar l, g;
+generate
+  for (l = 0 ; l < LEVELS ; l = l + 1) begin : level
+    for (g = 0 ; g < WIDTH ; g = g + 1) begin : gate
+      wire a = row[l*WIDTH + pick(g, 1)];
+      wire b = row[l*WIDTH + pick(g, 2)];
+      wire c = row[l*WIDTH + pick(g, 3)];
+      if (g % 3 == 0) begin : n
+        nand (row[(l+1)*WIDTH + g], a, b, c);
+      end else if (g % 3 == 1) begin : x
+        xor (row[(l+1)*WIDTH + g], a, b, c);
+      end else begin : o
+        nor (row[(l+1)*WIDTH + g], a, b, c);
+      end
+    end
+  end
+endgenerate
+
+integer i;
+reg [31:0] seed;
+
+initial begin
+  seed = 1;
+  for (i = 0 ; i < CYCLES ; i = i + 1) begin
+    in = {WIDTH/32{seed}};
+    seed = seed * 1664525 + 1013904223;
+    #1;
+  end
+  if (^row[LEVELS*WIDTH +: WIDTH] === 1'bx)
+    $display("FAILED -- output has X or Z bits");
+  else
+    $display("PASSED");
+  $finish;
+end
+
+endmodule
@@ -0,0 +1,56 @@
+// Two-state benchmark: behavioral code that works through a 64K word
+// memory, filling it, taking prefix sums and building a histogram in
+// a second memory. The design never uses X or Z, so it can also be
+// compiled in two-state mode. Compare the run time that "vvp -v"
+// prints for a design compiled normally and one compiled with
+//
+//     iverilog -ptwo_state=1 -o bench.vvp mem_two_state.v
+//
+// where the memories keep their words as native integers.
+module bench;
+
+localparam WORDS = 65536;
+localparam PASSES = 8;
+
+reg [31:0] mem  [0:WORDS-1];
+reg [15:0] hist [0:255];
+
+integer pass, idx;
+reg [31:0] seed, sum, check;
+
+initial begin
+  check = 0;
+  for (pass = 0 ; pass < PASSES ; pass = pass + 1) begin
+    seed = pass + 1;
+    for (idx = 0 ; idx < WORDS ; idx = idx + 1) begin
+      seed = seed * 1664525 + 1013904223;
+      mem[idx] = seed;
+    end
+
+    sum = 0;
+    for (idx = 0 ; idx < WORDS ; idx = idx + 1) begin
+      sum = sum + mem[idx];
+      mem[idx] = sum;
+    end
+
+    for (idx = 0 ; idx < 256 ; idx = idx + 1)
+      hist[idx] = 0;
+    for (idx = 0 ; idx < WORDS ; idx = idx + 1)
+      hist[mem[idx][31:24]] = hist[mem[idx][31:24]] + 1;
+
+    sum = 0;
+    for (idx = 0 ; idx < 256 ; idx = idx + 1)
+      sum = sum + hist[idx];
+    if (sum != WORDS) begin
+      $display("FAILED -- pass %0d: histogram holds %0d words", pass, sum);
+      $finish;
+    end
+    check = check ^ mem[WORDS-1] ^ hist[pass];
+  end
+
+  $display("check %h", check);
+  $display("PASSED");
+  $finish;
+end
+
+endmodule
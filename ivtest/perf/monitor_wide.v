@@ -0,0 +1,40 @@
+// $monitor benchmark: a $monitor of a few wide buses, shown in
+// decimal and hex, and of a small counter. Only the counter changes
+// every clock. The wide buses change rarely, so the time goes into
+// formatting the monitor line rather than into the simulation. Run it
+// with the output sent to /dev/null and compare the wall time (e.g.
+// with time(1)). The PASSED line is printed with $display, so use
+// "grep PASSED" to check the result.
+module bench;
+
+localparam CYCLES = 200000;
+
+reg clk = 0;
+reg [15:0] count = 0;
+reg [1023:0] bus_a = 0;
+reg [1023:0] bus_b = 0;
+reg [511:0]  bus_c = 0;
+
+always @(posedge clk) begin
+  count <= count + 1;
+  if (count[11:0] == 0) begin
+    bus_a <= {32{count, 16'h5a5a}};
+    bus_b <= ~bus_a;
+    bus_c <= bus_a[767:256] ^ {16{count, count}};
+  end
+end
+
+always #5 clk = ~clk;
+
+initial begin
+  $monitor("%0d a=%d b=%h c=%d", count, bus_a, bus_b, bus_c);
+  #(CYCLES*10);
+  $monitoroff;
+  if (count !== CYCLES[15:0])
+    $display("FAILED -- count = %0d", count);
+  else
+    $display("PASSED");
+  $finish;
+end
+
+endmodule
@@ -0,0 +1,36 @@
+// $readmemh benchmark: write an image of 8M 32-bit words (a 32 MB ROM,
+// about 80 MB of hex text) with $writememh and load it back with
+// $readmemh, as a boot simulation does with a large ROM image. Compare
+// the run time printed by "vvp -v" to see the cost of the two tasks.
+module bench;
+
+localparam WORDS = 1 << 23;
+
+reg [31:0] rom [0:WORDS-1];
+
+integer idx;
+integer errors;
+
+initial begin
+  for (idx = 0 ; idx < WORDS ; idx = idx + 1)
+    rom[idx] = idx * 32'h9e3779b9;
+
+  $writememh("readmem_image.hex", rom);
+
+  for (idx = 0 ; idx < WORDS ; idx = idx + 1)
+    rom[idx] = 32'bx;
+
+  $readmemh("readmem_image.hex", rom);
+
+  errors = 0;
+  for (idx = 0 ; idx < WORDS ; idx = idx + 1)
+    if (rom[idx] !== idx * 32'h9e3779b9)
+      errors = errors + 1;
+
+  if (errors != 0)
+    $display("FAILED -- %0d words differ", errors);
+  else
+    $display("PASSED");
+end
+
+endmodule
@@ -0,0 +1,43 @@
+// Net partition benchmark: a number of identical, independent LFSR
+// cores built from continuous assignments. Each core has its own
+// clock and its own state, and nothing outside the cores connects
+// them, so the net graph of each core has two regions: the clock with
+// its edge event, and the state with its next state logic. Run with
+// "vvp -v", which should report 2*CORES (32) independent regions, and
+// a largest region the size of the next state logic of one core.
+module lfsr_core #(parameter PERIOD = 1);
+
+reg clk = 0;
+reg [31:0] state;
+
+wire feedback = state[31] ^ state[21] ^ state[1] ^ state[0];
+wire [31:0] next = {state[30:0], feedback};
+
+initial state = 32'h1;
+
+always #PERIOD clk = ~clk;
+
+always @(posedge clk)
+  state <= next;
+
+endmodule
+
+module bench;
+
+localparam CORES = 16;
+
+genvar g;
+generate
+  for (g = 0 ; g < CORES ; g = g + 1) begin : core
+    lfsr_core #(.PERIOD(g+1)) u ();
+  end
+endgenerate
+
+initial begin
+  #200000;
+  if (core[0].u.state !== 32'bx && core[CORES-1].u.state !== 32'bx)
+    $display("PASSED");
+  $finish;
+end
+
+endmodule
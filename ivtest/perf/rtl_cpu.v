@@ -0,0 +1,139 @@
+// Behavioral RTL benchmark: a small register machine written the way
+// RTL CPU models are, with a combinational decoder and ALU in always @*
+// blocks and the state updated in an always @(posedge clk) block. The
+// program fills a memory and folds it into a checksum, OUTER times
+// over, for a few hundred thousand clock cycles. Nearly all the time
+// goes into the behavioral code of the processes, so this measures the
+// thread instructions. vvp -v prints the run time and the number of
+// instructions executed; divide the cycle count that the design prints
+// by the run time to get cycles per second.
+module cpu(input clk, input rst, output reg halted, output [31:0] result);
+
+  localparam OP_ADDI = 0, OP_ADD = 1, OP_SUB = 2, OP_XOR = 3, OP_ROT = 4,
+             OP_BNE = 5, OP_ST = 6, OP_LD = 7, OP_HALT = 15;
+
+  reg [31:0] rom [0:31];
+  reg [31:0] regs [0:7];
+  reg [31:0] dmem [0:255];
+  reg [4:0]  pc;
+
+  reg [3:0]  op;
+  reg [2:0]  rd, rs, rt;
+  reg [31:0] imm, a, b, alu;
+
+  assign result = regs[1];
+
+  // Decode the instruction and read the registers.
+  always @* begin
+    op  = rom[pc][31:28];
+    rd  = rom[pc][27:25];
+    rs  = rom[pc][24:22];
+    rt  = rom[pc][21:19];
+    imm = {{16{rom[pc][15]}}, rom[pc][15:0]};
+    a   = regs[rs];
+    b   = regs[rt];
+  end
+
+  always @* begin
+    case (op)
+      OP_ADDI: alu = a + imm;
+      OP_ADD:  alu = a + b;
+      OP_SUB:  alu = a - b;
+      OP_XOR:  alu = a ^ b;
+      OP_ROT:  alu = {a[30:0], a[31]};
+      OP_LD:   alu = dmem[a[7:0]];
+      default: alu = 32'bx;
+    endcase
+  end
+
+  integer i;
+  always @(posedge clk) begin
+    if (rst) begin
+      pc <= 0;
+      halted <= 0;
+      for (i = 0 ; i < 8 ; i = i + 1)
+        regs[i] <= 0;
+    end else if (!halted) begin
+      pc <= pc + 1;
+      case (op)
+        OP_BNE:  if (a != b) pc <= imm[4:0];
+        OP_ST:   dmem[a[7:0]] <= b;
+        OP_HALT: halted <= 1;
+        default: if (rd != 0) regs[rd] <= alu;
+      endcase
+    end
+  end
+
+endmodule
+
+module bench;
+
+localparam OUTER = 200;
+
+reg clk = 0;
+reg rst = 1;
+wire halted;
+wire [31:0] result;
+
+cpu dut (clk, rst, halted, result);
+
+function [31:0] ins(input [3:0] op, input [2:0] rd, rs, rt,
+                    input [15:0] imm);
+  ins = {op, rd, rs, rt, 3'b000, imm};
+endfunction
+
+localparam OP_ADDI = 0, OP_ADD = 1, OP_ST = 6, OP_BNE = 5, OP_LD = 7,
+           OP_ROT = 4, OP_XOR = 3, OP_HALT = 15;
+
+// The same computation as the program, to check the result.
+reg [31:0] expect_sum;
+reg [31:0] expect_mem [0:255];
+integer o, k;
+initial begin
+  expect_sum = 0;
+  for (o = 0 ; o < OUTER ; o = o + 1) begin
+    for (k = 0 ; k < 256 ; k = k + 1)
+      expect_mem[k] = 3*k + expect_sum;
+    for (k = 0 ; k < 256 ; k = k + 1)
+      expect_sum = {expect_sum[30:0], expect_sum[31]} ^ expect_mem[k];
+  end
+end
+
+always #5 clk = ~clk;
+
+integer cycles;
+always @(posedge clk) cycles = cycles + 1;
+
+initial begin
+  //                      op  rd rs rt  imm
+  dut.rom[0]  = ins(OP_ADDI, 7, 0, 0, OUTER);
+  dut.rom[1]  = ins(OP_ADDI, 2, 0, 0, 0);     // fill loop
+  dut.rom[2]  = ins(OP_ADDI, 3, 0, 0, 256);
+  dut.rom[3]  = ins(OP_ADD,  4, 2, 2, 0);
+  dut.rom[4]  = ins(OP_ADD,  4, 4, 2, 0);
+  dut.rom[5]  = ins(OP_ADD,  4, 4, 1, 0);
+  dut.rom[6]  = ins(OP_ST,   0, 2, 4, 0);
+  dut.rom[7]  = ins(OP_ADDI, 2, 2, 0, 1);
+  dut.rom[8]  = ins(OP_BNE,  0, 2, 3, 3);
+  dut.rom[9]  = ins(OP_ADDI, 2, 0, 0, 0);     // checksum loop
+  dut.rom[10] = ins(OP_LD,   5, 2, 0, 0);
+  dut.rom[11] = ins(OP_ROT,  1, 1, 0, 0);
+  dut.rom[12] = ins(OP_XOR,  1, 1, 5, 0);
+  dut.rom[13] = ins(OP_ADDI, 2, 2, 0, 1);
+  dut.rom[14] = ins(OP_BNE,  0, 2, 3, 10);
+  dut.rom[15] = ins(OP_ADDI, 7, 7, 0, 16'hffff);
+  dut.rom[16] = ins(OP_BNE,  0, 7, 0, 1);
+  dut.rom[17] = ins(OP_HALT, 0, 0, 0, 0);
+
+  cycles = 0;
+  #12 rst = 0;
+  wait (halted);
+  $display("%0d cycles", cycles);
+  if (result !== expect_sum)
+    $display("FAILED -- result %h, expected %h", result, expect_sum);
+  else
+    $display("PASSED");
+  $finish;
+end
+
+endmodule
@@ -0,0 +1,27 @@
+// Scheduler benchmark: thousands of processes, each waiting on its own
+// delay, so that there are thousands of distinct pending time steps.
+// Compare the "events/second" line printed by "vvp -v" for the default
+// timing wheel and for the sorted list selected with -sched-list.
+module bench;
+
+localparam N = 4000;
+localparam CYCLES = 500;
+
+integer count = 0;
+
+genvar i;
+for (i = 0 ; i < N ; i = i + 1) begin : gen
+  initial begin
+    repeat (CYCLES) begin
+      #(i * 13 + 7);
+      count = count + 1;
+    end
+  end
+end
+
+initial begin
+  wait (count == N * CYCLES);
+  $display("PASSED");
+end
+
+endmodule
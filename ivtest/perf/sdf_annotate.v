@@ -0,0 +1,70 @@
+// SDF annotation benchmark: a gate netlist of GROUPS x CELLS small
+// cells, where every cell gets an IOPATH delay from an SDF file. The
+// SDF file is written by the design itself before it is annotated, so
+// nothing else is needed. Each cell is found by its hierarchical
+// instance name, so this measures the VPI name lookup. Compare the wall
+// time (e.g. with time(1)) with and without +nosdf; in the second case
+// the file is still written but not annotated, and the default delays
+// are checked instead.
+module cell(output y, input a);
+  buf (y, a);
+  specify
+    (a => y) = (1, 1);
+  endspecify
+endmodule
+
+module group #(parameter CELLS = 1) (output y, input a);
+  wire [CELLS-1:0] cy;
+  cell u[CELLS-1:0] (cy, a);
+  assign y = &cy;
+endmodule
+
+module bench;
+
+localparam GROUPS = 400;
+localparam CELLS = 250;
+
+reg a = 0;
+wire [GROUPS-1:0] y;
+
+group #(.CELLS(CELLS)) g[GROUPS-1:0] (y, a);
+
+integer fd, gi, ci, delay;
+
+initial begin
+  fd = $fopen("sdf_annotate.sdf", "w");
+  $fdisplay(fd, "(DELAYFILE");
+  $fdisplay(fd, " (SDFVERSION \"3.0\")");
+  $fdisplay(fd, " (DESIGN \"bench\")");
+  $fdisplay(fd, " (DIVIDER .)");
+  $fdisplay(fd, " (TIMESCALE 1s)");
+  for (gi = 0 ; gi < GROUPS ; gi = gi + 1)
+    for (ci = 0 ; ci < CELLS ; ci = ci + 1) begin
+      $fdisplay(fd, " (CELL (CELLTYPE \"cell\") (INSTANCE g\\[%0d\\].u\\[%0d\\])",
+                gi, ci);
+      $fdisplay(fd, "  (DELAY (ABSOLUTE (IOPATH a y (5) (5)))))");
+    end
+  $fdisplay(fd, ")");
+  $fclose(fd);
+
+  delay = 1;
+  if (!$test$plusargs("nosdf")) begin
+    $sdf_annotate("sdf_annotate.sdf");
+    delay = 5;
+  end
+
+  #10 a = 1;
+  #(delay - 1);
+  if (y !== 0) begin
+    $display("FAILED -- y changed early");
+    $finish;
+  end
+  #1;
+  if (y !== {GROUPS{1'b1}})
+    $display("FAILED -- y = %b", y);
+  else
+    $display("PASSED");
+  $finish;
+end
+
+endmodule
@@ -0,0 +1,37 @@
+// Memory benchmark: a 2^28 word memory model, of which only a scattered
+// few words are used, as in a testbench model of a large DRAM. Compare
+// the time and memory printed by "vvp -v" for the default sparse array
+// storage and for the normal storage selected with -sparse-array=0,
+// which needs about 4 GB for this memory.
+module bench;
+
+localparam WORDS = 1 << 28;
+localparam N = 200000;
+
+reg [31:0] mem [0:WORDS-1];
+
+integer idx;
+reg [31:0] addr;
+reg [31:0] sum;
+
+initial begin
+  addr = 1;
+  for (idx = 0 ; idx < N ; idx = idx + 1) begin
+    addr = addr * 1103515245 + 12345;
+    mem[addr % WORDS] = idx;
+  end
+
+  addr = 1;
+  sum = 0;
+  for (idx = 0 ; idx < N ; idx = idx + 1) begin
+    addr = addr * 1103515245 + 12345;
+    sum = sum + (mem[addr % WORDS] === idx);
+  end
+
+  if (sum != N)
+    $display("FAILED -- only %0d of %0d words read back", sum, N);
+  else
+    $display("PASSED");
+end
+
+endmodule
@@ -0,0 +1,34 @@
+// Startup benchmark: a large generated netlist that does very little
+// at run time, so that the time is in loading the .vvp file. Compare
+// the "Parsed VVP file" and compile cleanup times that vvp -v prints.
+module cell(input wire a, b, c, output wire y);
+  wire n1, n2;
+  nand g1 (n1, a, b);
+  nor  g2 (n2, b, c);
+  xor  g3 (y, n1, n2);
+endmodule
+
+module bench;
+
+localparam CELLS = 20000;
+
+reg [2:0] in;
+wire [CELLS:0] chain;
+
+assign chain[0] = in[0];
+
+genvar g;
+generate
+  for (g = 0 ; g < CELLS ; g = g + 1) begin : c
+    cell u (chain[g], in[1], in[2], chain[g+1]);
+  end
+endgenerate
+
+initial begin
+  in = 3'b101;
+  #1;
+  if (chain[CELLS] !== 1'bx)
+    $display("PASSED");
+end
+
+endmodule
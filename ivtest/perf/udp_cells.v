@@ -0,0 +1,60 @@
+// UDP benchmark: a gate-level style netlist of combinational and
+// sequential UDP cells. Each stage is a 4-input AND-OR cell feeding a
+// flip-flop with reset, and the stages are chained into a ring so
+// that the cells keep switching.
+primitive ao22 (y, a, b, c, d);
+  output y;
+  input a, b, c, d;
+  table
+  // a b c d : y
+     1 1 ? ? : 1;
+     ? ? 1 1 : 1;
+     0 ? 0 ? : 0;
+     0 ? ? 0 : 0;
+     ? 0 0 ? : 0;
+     ? 0 ? 0 : 0;
+  endtable
+endprimitive
+
+primitive dffr (q, clk, d, rn);
+  output q;
+  reg q;
+  input clk, d, rn;
+  table
+  // clk d rn : q : q+
+     ?   ?  0 : ? : 0;
+     r   0  1 : ? : 0;
+     r   1  1 : ? : 1;
+     f   ?  1 : ? : -;
+     ?   *  1 : ? : -;
+     ?   ?  r : ? : -;
+  endtable
+endprimitive
+
+module bench;
+
+localparam STAGES = 256;
+
+reg clk = 0, rn = 0;
+wire [STAGES-1:0] q, y;
+
+genvar g;
+generate
+  for (g = 0 ; g < STAGES ; g = g + 1) begin : stage
+    ao22 c (y[g], q[(g+1)%STAGES], ~q[(g+3)%STAGES],
+                  q[(g+5)%STAGES], q[(g+7)%STAGES]);
+    dffr f (q[g], clk, g == 0 ? ~y[g] : y[g], rn);
+  end
+endgenerate
+
+always #5 clk = ~clk;
+
+initial begin
+  #12 rn = 1;
+  #200000;
+  if (q !== {STAGES{1'bx}})
+    $display("PASSED");
+  $finish;
+end
+
+endmodule
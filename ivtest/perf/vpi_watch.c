@@ -0,0 +1,130 @@
+/*
+ * A VPI client in the style of cocotb: $watch_scope walks the scope
+ * tree below its argument (but not the argument itself) and puts a
+ * value change callback on every reg and net it finds, $watch_part puts value change callbacks on its
+ * (part select) arguments, and $watch_count returns the number of
+ * callbacks that have been run.
+ */
+#include <string.h>
+#include "vpi_user.h"
+
+static PLI_INT32 watch_count = 0;
+static PLI_INT32 watch_sum = 0;
+
+static PLI_INT32 value_changed(p_cb_data cb)
+{
+    watch_count += 1;
+    watch_sum += cb->value->value.integer;
+    return 0;
+}
+
+static void watch_object(vpiHandle obj)
+{
+    static s_vpi_time time = { vpiSuppressTime, 0, 0, 0.0 };
+    static s_vpi_value value = { vpiIntVal, { 0 } };
+    s_cb_data cb;
+
+    memset(&cb, 0, sizeof(cb));
+    cb.reason = cbValueChange;
+    cb.cb_rtn = value_changed;
+    cb.obj = obj;
+    cb.time = &time;
+    cb.value = &value;
+    vpi_register_cb(&cb);
+}
+
+static void watch_type(vpiHandle scope, PLI_INT32 type)
+{
+    vpiHandle iter = vpi_iterate(type, scope);
+    vpiHandle item;
+
+    if (iter == 0) return;
+    while ((item = vpi_scan(iter)))
+        watch_object(item);
+}
+
+static void watch_tree(vpiHandle scope)
+{
+    vpiHandle iter, item;
+
+    watch_type(scope, vpiReg);
+    watch_type(scope, vpiNet);
+
+    iter = vpi_iterate(vpiInternalScope, scope);
+    if (iter == 0) return;
+    while ((item = vpi_scan(iter)))
+        watch_tree(item);
+}
+
+static PLI_INT32 watch_scope_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+    vpiHandle callh = vpi_handle(vpiSysTfCall, 0);
+    vpiHandle argv = vpi_iterate(vpiArgument, callh);
+    vpiHandle item, iter, sub;
+
+    (void) name; /* Not used */
+    while ((item = vpi_scan(argv))) {
+        iter = vpi_iterate(vpiInternalScope, item);
+        if (iter == 0) continue;
+        while ((sub = vpi_scan(iter)))
+            watch_tree(sub);
+    }
+    return 0;
+}
+
+static PLI_INT32 watch_part_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+    vpiHandle callh = vpi_handle(vpiSysTfCall, 0);
+    vpiHandle argv = vpi_iterate(vpiArgument, callh);
+    vpiHandle item;
+
+    (void) name; /* Not used */
+    while ((item = vpi_scan(argv)))
+        watch_object(item);
+    return 0;
+}
+
+static PLI_INT32 watch_count_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+    vpiHandle callh = vpi_handle(vpiSysTfCall, 0);
+    s_vpi_value val;
+
+    (void) name; /* Not used */
+    val.format = vpiIntVal;
+    val.value.integer = watch_count;
+    vpi_put_value(callh, &val, 0, vpiNoDelay);
+    return 0;
+}
+
+static PLI_INT32 watch_count_sizetf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+    (void) name; /* Not used */
+    return 32;
+}
+
+static void watch_register(void)
+{
+    s_vpi_systf_data tf_data;
+
+    memset(&tf_data, 0, sizeof(tf_data));
+    tf_data.type = vpiSysTask;
+    tf_data.tfname = "$watch_scope";
+    tf_data.calltf = watch_scope_calltf;
+    vpi_register_systf(&tf_data);
+
+    tf_data.tfname = "$watch_part";
+    tf_data.calltf = watch_part_calltf;
+    vpi_register_systf(&tf_data);
+
+    tf_data.type = vpiSysFunc;
+    tf_data.sysfunctype = vpiIntFunc;
+    tf_data.tfname = "$watch_count";
+    tf_data.calltf = watch_count_calltf;
+    tf_data.sizetf = watch_count_sizetf;
+    vpi_register_systf(&tf_data);
+}
+
+void (*vlog_startup_routines[])(void) = {
+    watch_register,
+    0
+};
@@ -0,0 +1,54 @@
+// VPI value change benchmark: a cocotb-style client (vpi_watch.c) that
+// finds 50000 signals by walking the scope tree and puts a value change
+// callback on each of them, plus callbacks on byte-wide part selects of
+// a bus whose other bits change every cycle. Build and run it with:
+//
+//    iverilog-vpi vpi_watch.c
+//    iverilog -o bench.vvp vpi_watch.v
+//    vvp -v -M. -mvpi_watch bench.vvp
+//
+// and compare the run time that "vvp -v" prints.
+module bench;
+
+localparam N = 50000;
+localparam CYCLES = 200;
+
+reg clk = 0;
+reg [1:0] phase = 0;
+reg [31:0] count_hi = 0;
+
+genvar g;
+for (g = 0 ; g < N ; g = g + 1) begin : cell
+  reg [7:0] r = 0;
+  always @(posedge clk)
+    if (phase == g % 4) r <= r + 1;
+end
+
+  // The low bytes of the bus never change, so the part select callbacks
+  // on them never trigger although the bus changes every cycle.
+wire [63:0] bus;
+assign bus[31:0] = 32'h0;
+assign bus[63:32] = count_hi;
+
+integer expect;
+
+initial begin
+  #1 $watch_scope(bench);
+  $watch_part(bus[7:0], bus[15:8], bus[23:16], bus[31:24]);
+  repeat (CYCLES) begin
+    #1 clk = 1;
+    #1 clk = 0;
+    phase = phase + 1;
+    count_hi = count_hi + 1;
+  end
+  #1;
+    // Each cycle a quarter of the cells change.
+  expect = N / 4 * CYCLES;
+  if ($watch_count !== expect)
+    $display("FAILED -- %0d callbacks, expected %0d", $watch_count, expect);
+  else
+    $display("PASSED");
+  $finish(0);
+end
+
+endmodule
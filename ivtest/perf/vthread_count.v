@@ -0,0 +1,24 @@
+// Thread benchmark: a tight behavioral loop of loads, stores, compares
+// and conditional jumps. Compare the "instructions/second" line printed
+// by "vvp -v" for the default threaded dispatch and -dispatch-call.
+module bench;
+
+reg [31:0] count;
+reg [31:0] even;
+integer i;
+
+initial begin
+  count = 0;
+  even = 0;
+  for (i = 0 ; i < 2000000 ; i = i + 1) begin
+    count = count + 1;
+    if (count[0] == 1'b0)
+      even = even + 1;
+  end
+  if (even === 32'd1000000)
+    $display("PASSED");
+  else
+    $display("FAILED: even = %0d", even);
+end
+
+endmodule
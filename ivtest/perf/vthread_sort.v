@@ -0,0 +1,33 @@
+// Thread benchmark: a bubble sort of a memory, which mixes array
+// loads and stores with compares and jumps.
+module bench;
+
+localparam N = 1000;
+
+reg [31:0] mem [0:N-1];
+reg [31:0] tmp;
+integer i, j;
+reg failed = 0;
+
+initial begin
+  for (i = 0 ; i < N ; i = i + 1)
+    mem[i] = (i * 7919) % N;
+
+  for (i = 0 ; i < N ; i = i + 1)
+    for (j = 0 ; j < N - 1 - i ; j = j + 1)
+      if (mem[j] > mem[j+1]) begin
+        tmp = mem[j];
+        mem[j] = mem[j+1];
+        mem[j+1] = tmp;
+      end
+
+  for (i = 0 ; i < N ; i = i + 1)
+    if (mem[i] !== i) failed = 1;
+
+  if (!failed)
+    $display("PASSED");
+  else
+    $display("FAILED");
+end
+
+endmodule
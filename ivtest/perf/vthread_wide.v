@@ -0,0 +1,21 @@
+// Thread benchmark: wide vector arithmetic and logic in a behavioral
+// loop, so that the instructions work on multi-word vectors.
+module bench;
+
+reg [255:0] a, b, c;
+integer i;
+
+initial begin
+  a = {8{32'h9e3779b9}};
+  b = 256'd1;
+  c = 0;
+  for (i = 0 ; i < 500000 ; i = i + 1) begin
+    b = b + a;
+    c = c ^ (b - {a[127:0], a[255:128]});
+    a = a | (b & 256'hff);
+  end
+  if (c !== 256'bx)
+    $display("PASSED");
+end
+
+endmodule
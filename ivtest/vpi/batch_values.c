@@ -0,0 +1,101 @@
+#include <assert.h>
+#include "vpi_user.h"
+
+#define MAX_ARGS 16
+#define MAX_VALS 64
+
+static unsigned get_args(vpiHandle*handles, unsigned*sizes)
+{
+    vpiHandle callh = vpi_handle(vpiSysTfCall, 0);
+    vpiHandle argv = vpi_iterate(vpiArgument, callh);
+    vpiHandle item;
+    unsigned count = 0;
+
+    assert(argv);
+    while ((item = vpi_scan(argv))) {
+        assert(count < MAX_ARGS);
+        handles[count] = item;
+        sizes[count] = vpi_get(vpiSize, item);
+        count += 1;
+    }
+    return count;
+}
+
+static PLI_INT32 get_values_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+    vpiHandle handles[MAX_ARGS];
+    unsigned sizes[MAX_ARGS];
+    s_vpi_vecval vals[MAX_VALS];
+    unsigned count, idx, wdx, off;
+    PLI_INT32 rc;
+
+    (void) name; /* Not used */
+    count = get_args(handles, sizes);
+    rc = vpip_get_values(count, handles, vals);
+    vpi_printf("vpip_get_values read %d of %u objects\n", (int)rc, count);
+
+    off = 0;
+    for (idx = 0 ; idx < (unsigned)rc ; idx += 1) {
+        unsigned hwid = (sizes[idx] + 31) / 32;
+        vpi_printf("  %s (%u bits):", vpi_get_str(vpiName, handles[idx]),
+                   sizes[idx]);
+        for (wdx = hwid ; wdx > 0 ; wdx -= 1)
+            vpi_printf(" %08x/%08x", (unsigned)vals[off+wdx-1].aval,
+                       (unsigned)vals[off+wdx-1].bval);
+        vpi_printf("\n");
+        off += hwid;
+    }
+    return 0;
+}
+
+static PLI_INT32 put_values_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+    vpiHandle handles[MAX_ARGS];
+    unsigned sizes[MAX_ARGS];
+    s_vpi_vecval vals[MAX_VALS];
+    unsigned count, idx, off;
+    PLI_INT32 rc;
+
+    (void) name; /* Not used */
+    count = get_args(handles, sizes);
+
+      /* Fill the words with a pattern, and make the low bits of the
+         last object x and z. */
+    off = 0;
+    for (idx = 0 ; idx < count ; idx += 1)
+        off += (sizes[idx] + 31) / 32;
+    assert(off <= MAX_VALS);
+    for (idx = 0 ; idx < off ; idx += 1) {
+        vals[idx].aval = 0x5a5a5a5a ^ (idx * 0x01010101);
+        vals[idx].bval = 0;
+    }
+    vals[off-1].aval = 0x6;
+    vals[off-1].bval = 0xc;
+
+    rc = vpip_put_values(count, handles, vals);
+    vpi_printf("vpip_put_values wrote %d of %u objects\n", (int)rc, count);
+    return 0;
+}
+
+static void batch_values_register(void)
+{
+    s_vpi_systf_data tf_data;
+
+    tf_data.type      = vpiSysTask;
+    tf_data.sysfunctype = 0;
+    tf_data.tfname    = "$get_values";
+    tf_data.calltf    = get_values_calltf;
+    tf_data.compiletf = 0;
+    tf_data.sizetf    = 0;
+    tf_data.user_data = 0;
+    vpi_register_systf(&tf_data);
+
+    tf_data.tfname    = "$put_values";
+    tf_data.calltf    = put_values_calltf;
+    vpi_register_systf(&tf_data);
+}
+
+void (*vlog_startup_routines[])(void) = {
+    batch_values_register,
+    0
+};
@@ -0,0 +1,33 @@
+module top;
+  reg a;
+  reg [7:0] b;
+  reg [39:0] c;
+  wire [3:0] w;
+  reg [15:0] mem [0:3];
+  integer i;
+  real r;
+
+  assign w = b[5:2];
+
+  initial begin
+    a = 1'bx;
+    b = 8'b1010_xz01;
+    c = 40'h12_3456_789a;
+    mem[1] = 16'hbeef;
+    i = -2;
+    r = 1.5;
+
+    #1;
+    $get_values(a, b, c, w, c[19:4], mem[1], i);
+      // The real stops the batch.
+    $get_values(b, r, c);
+
+    $put_values(a, b, c, c[35:32], mem[2]);
+    #1;
+    $display("a = %b, b = %b, c = %h, mem[2] = %b", a, b, c, mem[2]);
+    $get_values(a, b, c, w, mem[2]);
+    $put_values(i, r, b);
+    #1;
+    $display("i = %h, b = %b", i, b);
+  end
+endmodule
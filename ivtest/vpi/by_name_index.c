@@ -0,0 +1,89 @@
+#include <assert.h>
+#include "vpi_user.h"
+
+static void lookup(const char*name, vpiHandle scope)
+{
+    vpiHandle item = vpi_handle_by_name(name, scope);
+
+    if (scope)
+        vpi_printf("%s in %s: ", name, vpi_get_str(vpiFullName, scope));
+    else
+        vpi_printf("%s: ", name);
+
+    if (item == 0) {
+        vpi_printf("not found\n");
+        return;
+    }
+    vpi_printf("%s", vpi_get_str(vpiType, item));
+    vpi_printf(" %s\n", vpi_get_str(vpiFullName, item));
+}
+
+static PLI_INT32 check_names_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+    vpiHandle callh = vpi_handle(vpiSysTfCall, 0);
+    vpiHandle top, u;
+
+    (void) name; /* Not used */
+
+      /* Root modules and paths from the root. */
+    lookup("other", 0);
+    lookup("sub", 0);
+    lookup("other.u", 0);
+    lookup("other.u.x", 0);
+    lookup("top.u.x", 0);
+
+      /* A scope and an item with the same name. */
+    lookup("top.top", 0);
+    lookup("top.top.x", 0);
+    lookup("top", 0);
+    lookup("top.t", 0);
+    lookup("top.t.t", 0);
+    lookup("top.named", 0);
+    lookup("top.named.named", 0);
+
+      /* Generate scopes. */
+    lookup("top.blk[0]", 0);
+    lookup("top.blk[1].r", 0);
+    lookup("top.blk[2]", 0);
+
+      /* Escaped identifiers. */
+    lookup("top.\\esc.name ", 0);
+    lookup("top.\\inst.esc ", 0);
+    lookup("top.\\inst.esc .x", 0);
+
+      /* Array words. */
+    lookup("top.mem", 0);
+    lookup("top.mem[2]", 0);
+    lookup("top.mem[4]", 0);
+
+      /* Names relative to a scope. */
+    top = vpi_handle(vpiScope, vpi_handle(vpiScope, callh));
+    assert(top);
+    u = vpi_handle_by_name("top.u", 0);
+    assert(u);
+    lookup("r", top);
+    lookup("blk[1].r", top);
+    lookup("mem[1]", top);
+    lookup("nosuch", top);
+    lookup("x", u);
+    lookup("u.x", u);
+    return 0;
+}
+
+static void check_names_register(void)
+{
+    s_vpi_systf_data tf_data;
+
+    tf_data.type      = vpiSysTask;
+    tf_data.tfname    = "$check_names";
+    tf_data.calltf    = check_names_calltf;
+    tf_data.compiletf = 0;
+    tf_data.sizetf    = 0;
+    tf_data.user_data = 0;
+    vpi_register_systf(&tf_data);
+}
+
+void (*vlog_startup_routines[])(void) = {
+    check_names_register,
+    0
+};
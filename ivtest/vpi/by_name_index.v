@@ -0,0 +1,34 @@
+// Look up items through the name index of each scope.
+module sub;
+  reg x;
+endmodule
+
+module top;
+  reg [7:0] mem [0:3];
+  reg r;
+  wire \esc.name ;
+
+  task t;
+    reg t;
+    t = 1'b1;
+  endtask
+
+  genvar gi;
+  generate for (gi = 0 ; gi < 2 ; gi = gi + 1) begin : blk
+    reg r;
+  end endgenerate
+
+  // Instances with the same name as the scope that holds them.
+  sub top();
+  sub u();
+  sub \inst.esc ();
+
+  initial begin : named
+    reg named;
+    #1 $check_names;
+  end
+endmodule
+
+module other;
+  sub u();
+endmodule
@@ -0,0 +1,119 @@
+#include <assert.h>
+#include <string.h>
+#include "vpi_user.h"
+
+struct watch_s {
+    const char*label;
+    vpiHandle obj;
+    vpiHandle cb;
+};
+
+static struct watch_s watches[6];
+static unsigned nwatches = 0;
+static struct watch_s*lo_watch = 0;
+
+static PLI_INT32 report_change(p_cb_data cb);
+static PLI_INT32 remove_change(p_cb_data cb);
+
+static struct watch_s*add_watch(const char*label, vpiHandle obj,
+                                PLI_INT32 (*rtn)(p_cb_data))
+{
+    s_cb_data cb;
+    s_vpi_time time;
+    s_vpi_value value;
+    struct watch_s*watch;
+
+    assert(nwatches < sizeof(watches)/sizeof(watches[0]));
+    watch = watches + nwatches++;
+    watch->label = label;
+    watch->obj = obj;
+
+    memset(&cb, 0, sizeof(cb));
+    time.type = vpiSuppressTime;
+    value.format = vpiSuppressVal;
+    cb.reason = cbValueChange;
+    cb.cb_rtn = rtn;
+    cb.obj = obj;
+    cb.time = &time;
+    cb.value = &value;
+    cb.user_data = (PLI_BYTE8*)watch;
+    watch->cb = vpi_register_cb(&cb);
+    assert(watch->cb);
+    return watch;
+}
+
+static PLI_UINT32 sim_time(void)
+{
+    s_vpi_time time;
+    time.type = vpiSimTime;
+    vpi_get_time(0, &time);
+    return time.low;
+}
+
+static PLI_INT32 report_change(p_cb_data cb)
+{
+    struct watch_s*watch = (struct watch_s*)cb->user_data;
+    s_vpi_value value;
+
+    value.format = vpiHexStrVal;
+    vpi_get_value(watch->obj, &value);
+    vpi_printf("At time %u %s = %s\n", (unsigned)sim_time(),
+               watch->label, value.value.str);
+    return 0;
+}
+
+  /* The newest callback runs first. It removes itself and the older
+     sig[3:0] callback, which has not run yet for this change, and
+     adds a callback that must not run until the next change. */
+static PLI_INT32 remove_change(p_cb_data cb)
+{
+    struct watch_s*watch = (struct watch_s*)cb->user_data;
+
+    vpi_printf("At time %u remover: removing itself and %s, adding added\n",
+               (unsigned)sim_time(), lo_watch->label);
+    vpi_remove_cb(watch->cb);
+    vpi_remove_cb(lo_watch->cb);
+    add_watch("added", watch->obj, report_change);
+    return 0;
+}
+
+static PLI_INT32 watch_list_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
+{
+    vpiHandle callh = vpi_handle(vpiSysTfCall, 0);
+    vpiHandle argv = vpi_iterate(vpiArgument, callh);
+    vpiHandle sig, lo, mid, hi;
+
+    (void) name; /* Not used */
+    assert(argv);
+    sig = vpi_scan(argv);
+    lo = vpi_scan(argv);
+    mid = vpi_scan(argv);
+    hi = vpi_scan(argv);
+    assert(sig && lo && mid && hi);
+    vpi_free_object(argv);
+
+    add_watch("sig", sig, report_change);
+    lo_watch = add_watch("sig[3:0]", lo, report_change);
+    add_watch("sig[11:8]", mid, report_change);
+    add_watch("sig[15:12]", hi, report_change);
+    add_watch("remover", sig, remove_change);
+    return 0;
+}
+
+static void watch_list_register(void)
+{
+    s_vpi_systf_data tf_data;
+
+    tf_data.type      = vpiSysTask;
+    tf_data.tfname    = "$watch_list";
+    tf_data.calltf    = watch_list_calltf;
+    tf_data.compiletf = 0;
+    tf_data.sizetf    = 0;
+    tf_data.user_data = 0;
+    vpi_register_systf(&tf_data);
+}
+
+void (*vlog_startup_routines[])(void) = {
+    watch_list_register,
+    0
+};
@@ -0,0 +1,17 @@
+// Check the value change callback list of a signal. Callbacks on
+// part selects must only run when their bits change, and a callback
+// may remove itself and a sibling, and add a new callback, while the
+// list is running.
+module test;
+  reg [15:0] sig;
+
+  initial begin
+    sig = 16'h0000;
+    $watch_list(sig, sig[3:0], sig[11:8], sig[15:12]);
+    #1 sig[3:0] = 4'h5;
+    #1 sig[11:8] = 4'ha;
+    #1 sig = 16'hf0f0;
+    #1 sig[7:4] = 4'h3;
+    #1 sig = 16'h1234;
+  end
+endmodule
@@ -1085,6 +1085,9 @@ void Design::del_node(NetNode*net)
       if (net == nodes_functor_cur_)
 	    nodes_functor_cur_ = 0;
 
+	/* Drop the node from the work list, if it is there. */
+      node_queued_.erase(net);
+
 	/* Now perform the actual delete. */
       if (nodes_ == net)
 	    nodes_ = net->node_prev_;
@@ -47,29 +47,35 @@ void Nexus::connect(Link&r)
 	    if (r.next_ == 0) {
 		  list_ = &r;
 		  r.next_ = &r;
+		  r.prev_ = &r;
+		  r.tail_ = true;
 		  r.nexus_ = this;
+		  refs_ += 1;
 		  driven_ = NO_GUESS;
 	    } else {
 		  driven_ = r_nexus->driven_;
 		  list_ = r_nexus->list_;
-		  list_->nexus_ = this;
 		  r_nexus->list_ = 0;
-		  delete r_nexus;
+		  r_nexus->forward_ = this;
+		  refs_ += 1;
 	    }
 	    return;
       }
 
 	// Special case: The Link is unconnected. Put it at the end of
-	// the current list and move the list_ pointer and nexus_ back
-	// pointer to suit.
+	// the current list and move the list_ pointer to suit.
       if (r.next_ == 0) {
 	    if (r.get_dir() != Link::INPUT)
 		  driven_ = NO_GUESS;
 
 	    r.nexus_ = this;
+	    refs_ += 1;
 	    r.next_ = list_->next_;
+	    r.prev_ = list_;
+	    list_->next_->prev_ = &r;
 	    list_->next_ = &r;
-	    list_->nexus_ = 0;
+	    list_->tail_ = false;
+	    r.tail_ = true;
 	    list_ = &r;
 	    return;
       }
@@ -78,16 +84,20 @@ void Nexus::connect(Link&r)
 	    driven_ = NO_GUESS;
 
 	// Splice the list of links from the "tmp" nexus to the end of
-	// this nexus. Adjust the nexus pointers as needed.
+	// this nexus. The links of the old nexus still point to it,
+	// so leave it behind as a stub that forwards to this one.
       Link*save_first = list_->next_;
-      list_->next_ = r_nexus->list_->next_;
+      Link*r_first = r_nexus->list_->next_;
+      list_->next_ = r_first;
+      r_first->prev_ = list_;
       r_nexus->list_->next_ = save_first;
-      list_->nexus_ = 0;
+      save_first->prev_ = r_nexus->list_;
+      list_->tail_ = false;
       list_ = r_nexus->list_;
-      list_->nexus_ = this;
 
       r_nexus->list_ = 0;
-      delete r_nexus;
+      r_nexus->forward_ = this;
+      refs_ += 1;
 }
 
 void connect(Link&l, Link&r)
@@ -111,7 +121,7 @@ void connect(Link&l, Link&r)
 
 Link::Link()
 : dir_(PASSIVE), drive0_(IVL_DR_STRONG), drive1_(IVL_DR_STRONG),
-  next_(0), nexus_(0)
+  tail_(false), next_(0), prev_(0), nexus_(0)
 {
       node_ = 0;
       pin_zero_ = true;
@@ -127,14 +137,46 @@ Link::~Link()
       }
 }
 
+/*
+ * The nexus_ pointer of a linked Link may point to a stub left behind
+ * when its Nexus was merged into another. Follow the forward_ pointers
+ * to the live Nexus, then point the link and the stubs on the way
+ * directly at it so that the next lookup is quick.
+ */
 Nexus* Link::find_nexus_() const
 {
       assert(next_);
-      if (nexus_) return nexus_;
-      for (Link*cur = next_ ; cur != this ; cur = cur->next_) {
-	    if (cur->nexus_) return cur->nexus_;
+      Nexus*root = nexus_;
+      while (root->forward_)
+	    root = root->forward_;
+
+      if (nexus_ == root)
+	    return root;
+
+	// Move the reference held by this link to the root. Then
+	// walk the path, dropping the reference we arrived by.
+      Nexus*cur = nexus_;
+      nexus_ = root;
+      root->refs_ += 1;
+      while (cur != root) {
+	    Nexus*nxt = cur->forward_;
+	    assert(cur->refs_ > 0);
+	    cur->refs_ -= 1;
+	    if (cur->refs_ == 0) {
+		    // Nothing else uses this stub. Its reference to
+		    // nxt is dropped in the next step.
+		  cur->forward_ = 0;
+		  delete cur;
+	    } else if (nxt == root) {
+		  return root;
+	    } else {
+		  cur->forward_ = root;
+		  root->refs_ += 1;
+	    }
+	    cur = nxt;
       }
-      return 0;
+      root->refs_ -= 1;
+      return root;
 }
 
 Nexus* Link::nexus()
@@ -239,13 +281,7 @@ bool Link::is_linked(const Link&that) const
       if (! that.is_linked())
 	    return false;
 
-      const Link*cur = next_;
-      while (cur != this) {
-	    if (cur == &that) return true;
-	    cur = cur->next_;
-      }
-
-      return false;
+      return find_nexus_() == that.find_nexus_();
 }
 
 Nexus::Nexus(Link&that)
@@ -253,32 +289,58 @@ Nexus::Nexus(Link&that)
       name_ = 0;
       driven_ = NO_GUESS;
       t_cookie_ = 0;
+      forward_ = 0;
+      refs_ = 0;
 
       if (that.next_ == 0) {
 	    list_ = &that;
 	    that.next_ = &that;
+	    that.prev_ = &that;
+	    that.tail_ = true;
 	    that.nexus_ = this;
+	    refs_ = 1;
 	    driven_ = NO_GUESS;
 
       } else {
 	    Nexus*tmp = that.find_nexus_();
 	    list_ = tmp->list_;
-	    list_->nexus_ = this;
 	    driven_ = tmp->driven_;
 	    name_ = tmp->name_;
 
 	    tmp->list_ = 0;
 	    tmp->name_ = 0;
-	    delete tmp;
+	    tmp->forward_ = this;
+	    refs_ = 1;
       }
 }
 
 Nexus::~Nexus()
 {
       assert(list_ == 0);
+      assert(refs_ == 0);
       delete[] name_;
 }
 
+/*
+ * Drop a reference to the nexus. Stubs that are no longer referenced
+ * are deleted, which in turn drops their reference to the Nexus they
+ * forward to. A live Nexus is deleted by its last Link instead.
+ */
+void Nexus::release_(Nexus*nex)
+{
+      while (nex) {
+	    assert(nex->refs_ > 0);
+	    nex->refs_ -= 1;
+	    if (nex->refs_ > 0 || nex->forward_ == 0)
+		  return;
+
+	    Nexus*nxt = nex->forward_;
+	    nex->forward_ = 0;
+	    delete nex;
+	    nex = nxt;
+      }
+}
+
 bool Nexus::assign_lval() const
 {
       for (const Link*cur = first_nlink() ; cur ; cur = cur->next_nlink()) {
@@ -395,40 +457,35 @@ void Nexus::unlink(Link*that)
 	// Special case: the Link is the only link in the nexus. In
 	// this case, the unlink is trivial. Also clear the Nexus
 	// pointers.
+      assert(that->nexus_ == this);
       if (that->next_ == that) {
-	    assert(that->nexus_ == this);
 	    assert(list_ == that);
 	    list_ = 0;
 	    driven_ = NO_GUESS;
-	    that->nexus_ = 0;
-	    that->next_ = 0;
-	    return;
-      }
 
-	// If the link I'm removing was a driver for this nexus, then
-	// cancel my guess of the driven value.
-      if (that->get_dir() != Link::INPUT)
-	    driven_ = NO_GUESS;
+      } else {
+	      // If the link I'm removing was a driver for this
+	      // nexus, then cancel my guess of the driven value.
+	    if (that->get_dir() != Link::INPUT)
+		  driven_ = NO_GUESS;
+
+	    Link*prev = that->prev_;
+	    prev->next_ = that->next_;
+	    that->next_->prev_ = prev;
 
-	// Look for the Link that points to "that". We know that there
-	// will be one because the list is a circle. When we find the
-	// prev pointer, then remove that from the list.
-      Link*prev = list_;
-      while (prev->next_ != that)
-	    prev = prev->next_;
-
-      prev->next_ = that->next_;
-
-	// If "that" was the last item in the list, then change the
-	// list_ pointer to point to the new end of the list.
-      if (list_ == that) {
-	    assert(that->nexus_ == this);
-	    list_ = prev;
-	    list_->nexus_ = this;
+	      // If "that" was the last item in the list, then change
+	      // the list_ pointer to point to the new end of the list.
+	    if (list_ == that) {
+		  list_ = prev;
+		  prev->tail_ = true;
+	    }
       }
 
+      that->tail_ = false;
       that->nexus_ = 0;
       that->next_ = 0;
+      that->prev_ = 0;
+      release_(this);
 }
 
 Link* Nexus::first_nlink()
@@ -445,18 +502,12 @@ const Link* Nexus::first_nlink() const
 
 /*
  * The t_cookie can be set exactly once. This attaches an ivl_nexus_t
- * object to the Nexus, and causes the Link list to be marked up for
- * efficient use by the code generator. The change is to give all the
- * links a valid nexus_ pointer. This breaks most of the other
- * methods, but they are not used during code generation.
+ * object to the Nexus for use by the code generator.
 */
 void Nexus::t_cookie(ivl_nexus_t val) const
 {
       assert(val && !t_cookie_);
       t_cookie_ = val;
-
-      for (Link*cur = list_->next_ ; cur->nexus_ == 0 ; cur = cur->next_)
-	    cur->nexus_ = const_cast<Nexus*> (this);
 }
 
 unsigned Nexus::vector_width() const
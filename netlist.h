@@ -189,16 +189,21 @@ class Link {
       DIR dir_           : 2;
       ivl_drive_t drive0_ : 3;
       ivl_drive_t drive1_ : 3;
+	// This is set for the last Link in the list of the nexus.
+      bool tail_         : 1;
 
     private:
       Nexus* find_nexus_() const;
 
     private:
-	// The Nexus uses these to maintain its list of Link
-	// objects. If this link is not connected to anything,
-	// then these pointers are both nil.
+	// The Nexus uses these to maintain its circular list of
+	// Link objects. If this link is not connected to anything,
+	// then these pointers are all nil. The nexus_ pointer may
+	// point to a Nexus that has been merged into another, in
+	// which case find_nexus_() follows the forward_ pointers.
       Link *next_;
-      Nexus*nexus_;
+      Link *prev_;
+      mutable Nexus*nexus_;
 
     private: // not implemented
       Link(const Link&);
@@ -344,18 +349,24 @@ class NetBranch  : public NetPins, public IslandBranch {
  * together. Each link has its own properties, this class holds the
  * properties of the group.
  *
- * The links in a nexus are grouped into a circularly linked list,
- * with the nexus pointing to the last Link. Each link in turn points
- * to the next link in the nexus, with the last link pointing back to
- * the first. The last link also has a non-nil nexus_ pointer back to
- * this nexus.
+ * The links in a nexus are grouped into a circular, doubly linked
+ * list, with the nexus pointing to the last Link. Each link points to
+ * the next and previous links in the nexus, and the last link has its
+ * tail_ bit set so that next_nlink() knows where the list ends.
+ *
+ * Every linked Link also has a nexus_ pointer, but it need not point
+ * to this Nexus directly. When two nexuses are connected, the links
+ * of one are spliced into the list of the other, and the absorbed
+ * Nexus stays behind as a stub whose forward_ pointer leads to the
+ * survivor. Link::find_nexus_() follows the forward_ chain to the live
+ * Nexus and then points the link (and the stubs it passed) straight
+ * at it, so that later lookups are a single step. The refs_ count of
+ * a Nexus is the number of links and stubs that point at it, and a
+ * stub is deleted when its count drops to zero.
  *
  * The t_cookie() is an ivl_nexus_t that the code generator uses to
  * store data in the nexus. When a Nexus is created, this cookie is
- * set to nil. The code generator may set the cookie once. This locks
- * the nexus, and rewrites the Link list to be optimal for the code
- * generator. In the process, *all* of the other methods are no longer
- * functional.
+ * set to nil. The code generator may set the cookie once.
  */
 class Nexus {
 
@@ -428,6 +439,15 @@ class Nexus {
       Link*list_;
       void unlink(Link*);
 
+	// When a Nexus is merged into another, it is kept as a stub
+	// that forwards to the surviving Nexus, so that the links
+	// that point to it need not all be updated. The refs_ count
+	// is the number of links and stubs that point here, and a
+	// stub is deleted when that drops to zero.
+      Nexus*forward_;
+      unsigned refs_;
+      static void release_(Nexus*nex);
+
       mutable char* name_; /* Cache the calculated name for the Nexus. */
       mutable ivl_nexus_t t_cookie_;
 
@@ -5177,6 +5197,11 @@ class Design {
 	// Iterate over the design...
       void dump(std::ostream&) const;
       void functor(struct functor_t*);
+	// Scan only the nodes on the work list. The functor may add
+	// more nodes to the list while this runs. Return the number
+	// of nodes visited.
+      void queue_node(NetNode*);
+      unsigned functor_queued(struct functor_t*);
       void join_islands(void);
       int emit(struct target_t*) const;
 
@@ -5210,6 +5235,10 @@ class Design {
 	// These are in support of the node functor iterator.
       NetNode*nodes_functor_cur_;
       NetNode*nodes_functor_nxt_;
+	// The node work list. The set holds the nodes that are still
+	// waiting, so that deleted nodes are dropped from the list.
+      std::list<NetNode*>node_queue_;
+      std::set<NetNode*>node_queued_;
 
 	// List the branches in the design.
       NetBranch*branches_;
@@ -5289,18 +5318,17 @@ inline __ObjectPathManip scope_path(const NetObj*obj)
 extern std::ostream& operator << (std::ostream&o, __ObjectPathManip);
 
 /*
- * If this link has a nexus_ pointer, then it is the last Link in the
- * list. next_nlink() returns 0 for the last Link.
+ * next_nlink() returns 0 for the last Link in the list.
  */
 inline Link* Link::next_nlink()
 {
-      if (nexus_) return 0;
+      if (tail_) return 0;
       else return next_;
 }
 
 inline const Link* Link::next_nlink() const
 {
-      if (nexus_) return 0;
+      if (tail_) return 0;
       else return next_;
 }
 
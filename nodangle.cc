@@ -25,6 +25,7 @@
  * for proper functioning of anything, but they can clean up the
  * appearance of design files that are generated.
  */
+# include  <vector>
 # include  "functor.h"
 # include  "netlist.h"
 # include  "compiler.h"
@@ -40,11 +41,17 @@ class nodangle_f  : public functor_t {
       unsigned stotal, etotal;
       bool scontinue, econtinue;
       bool scomplete, ecomplete;
+	// The number of signals and events looked at in this pass.
+      unsigned visited;
+	// The events that survived this pass. Only these need to be
+	// looked at in the next pass.
+      std::vector<NetEvent*> events;
 };
 
 void nodangle_f::event(Design*, NetEvent*ev)
 {
       if (ecomplete) return;
+      visited += 1;
 
 	/* If there are no references to this event, then go right
 	   ahead and delete it. There is no use looking further at
@@ -55,6 +62,8 @@ void nodangle_f::event(Design*, NetEvent*ev)
 	    return;
       }
 
+      events.push_back(ev);
+
       if (iteration == 0) {
               /* Try to remove duplicate probes from the event. This
                  is done as a separate initial pass to ensure similar
@@ -176,6 +185,7 @@ static void check_is_floating(NetNet*sig)
 void nodangle_f::signal(Design*, NetNet*sig)
 {
       if (scomplete) return;
+      visited += 1;
 
       if (warn_floating_nets && !sig->local_flag() && !floating_net_tested(sig)) {
 	    check_is_floating(sig);
@@ -271,7 +281,18 @@ void nodangle(Design*des)
 
             fun.scontinue = false;
             fun.econtinue = false;
-	    des->functor(&fun);
+	    fun.visited = 0;
+	    if (! fun.scomplete) {
+		  fun.events.clear();
+		  des->functor(&fun);
+	    } else {
+		    /* Once the signals are complete, only the events
+		       that survived the last pass are scanned again. */
+		  std::vector<NetEvent*> scan;
+		  scan.swap(fun.events);
+		  for (size_t idx = 0 ; idx < scan.size() ; idx += 1)
+			fun.event(des, scan[idx]);
+	    }
 	    fun.iteration += 1;
             fun.scomplete = !fun.scontinue;
             fun.ecomplete = !fun.econtinue;
@@ -279,7 +300,8 @@ void nodangle(Design*des)
 	    if (verbose_flag) {
 		  cout << " ... " << fun.iteration << " iterations"
 		       << " deleted " << fun.stotal << " dangling signals"
-		       << " and " << fun.etotal << " events." << endl << flush;
+		       << " and " << fun.etotal << " events"
+		       << " (visited " << fun.visited << ")." << endl << flush;
 	    }
 
       } while (fun.scontinue || fun.econtinue);
@@ -24,6 +24,10 @@
 
 # include  <cstring>
 # include  <cstdio> // sprintf()
+#if defined(HAVE_TIMES)
+# include  <unistd.h>
+# include  <sys/times.h>
+#endif
 # include  "compiler.h"
 # include  "t-dll.h"
 # include  "netclass.h"
@@ -38,6 +42,10 @@ using namespace std;
 
 struct dll_target dll_target_obj;
 
+#if defined(HAVE_TIMES)
+static struct tms emit_start;
+#endif
+
 #if defined(__WIN32__)
 
 inline ivl_dll_t ivl_dlopen(const char *name)
@@ -248,6 +256,10 @@ ivl_scope_t dll_target::find_scope(ivl_design_s &des, const NetScope*cur)
 {
       assert(cur);
 
+      unordered_map<const NetScope*,ivl_scope_t>::const_iterator hit = des.scope_map.find(cur);
+      if (hit != des.scope_map.end())
+	    return hit->second;
+
 	// If the scope is a PACKAGE, then it is a special kind of
 	// root scope and it in the packages array instead.
       if (cur->type() == NetScope::PACKAGE) {
@@ -287,6 +299,10 @@ ivl_scope_t dll_target::lookup_scope_(const NetScope*cur)
  */
 ivl_signal_t dll_target::find_signal(ivl_design_s &des, const NetNet*net)
 {
+      unordered_map<const NetNet*,ivl_signal_t>::const_iterator hit = des.signal_map.find(net);
+      if (hit != des.signal_map.end())
+	    return hit->second;
+
       ivl_scope_t scop = find_scope(des, net->scope());
       assert(scop);
 
@@ -662,6 +678,8 @@ void dll_target::add_root(const NetScope *s)
 	    assert(0);
 	    break;
       }
+
+      des_.scope_map[s] = root_;
 }
 
 bool dll_target::start_design(const Design*des)
@@ -686,6 +704,10 @@ bool dll_target::start_design(const Design*des)
 
       stmt_cur_ = 0;
 
+#if defined(HAVE_TIMES)
+      times(&emit_start);
+#endif
+
 	// Initialize the design object.
       des_.self = des;
       des_.time_precision = des->get_precision();
@@ -732,6 +754,15 @@ int dll_target::end_design(const Design*)
       int rc;
       if (errors == 0) {
 	    if (verbose_flag) {
+#if defined(HAVE_TIMES)
+		  struct tms emit_end;
+		  times(&emit_end);
+		  clock_t ticks = (emit_end.tms_utime + emit_end.tms_stime)
+			- (emit_start.tms_utime + emit_start.tms_stime);
+		  cout << " ... design scanned in "
+		       << ticks/(double)sysconf(_SC_CLK_TCK)
+		       << " seconds" << endl;
+#endif
 		  cout << " ... invoking target_design" << endl;
 	    }
 
@@ -2498,6 +2529,7 @@ void dll_target::scope(const NetScope*net)
 	    assert(scop->parent);
 	    scop->parent->children[net->fullname()] = scop;
 	    scop->parent->child .push_back(scop);
+	    des_.scope_map[net] = scop;
 	    scop->nlog_ = 0;
 	    scop->log_ = 0;
 	    scop->nevent_ = 0;
@@ -2595,6 +2627,7 @@ void dll_target::signal(const NetNet*net)
       FILE_NAME(obj, net);
 
       obj->scope_->sigs_.push_back(obj);
+      des_.signal_map[net] = obj;
 
 
 	/* Save the primitive properties of the signal in the
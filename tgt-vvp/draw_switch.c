@@ -38,6 +38,16 @@ void draw_switch_in_scope(ivl_switch_t sw)
       ivl_expr_t fall_exp = ivl_switch_delay(sw, 1);
       ivl_expr_t decay_exp= ivl_switch_delay(sw, 2);
 
+	/* Switches resolve the nets on both sides, which needs the Z
+	   value that two-state mode does not have. */
+      if (two_state_mode) {
+	    fprintf(stderr, "%s:%u: vvp.tgt error: Switches (and inout "
+		    "port connections) are not supported in two-state "
+		    "mode.\n", ivl_switch_file(sw), ivl_switch_lineno(sw));
+	    vvp_errors += 1;
+	    return;
+      }
+
       island = ivl_switch_island(sw);
       if (ivl_island_flag_test(island, 0) == 0)
 	    draw_tran_island(island);
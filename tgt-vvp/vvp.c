@@ -47,6 +47,7 @@ COPYRIGHT "\n\n"
 FILE*vvp_out = 0;
 int vvp_errors = 0;
 unsigned show_file_line = 0;
+unsigned two_state_mode = 0;
 
 int debug_draw = 0;
 
@@ -163,6 +164,10 @@ int target_design(ivl_design_t des)
 	 * The default is no file/line information will be included. */
       const char*fileline = ivl_design_flag(des, "fileline");
 
+	/* Use -ptwo_state to compile the design in two-state mode
+	 * (e.g. -ptwo_state=1). The default is four-state. */
+      const char*two_state = ivl_design_flag(des, "two_state");
+
       const char*debug_flags = ivl_design_flag(des, "debug_flags");
       process_debug_string(debug_flags);
 
@@ -194,6 +199,9 @@ int target_design(ivl_design_t des)
             show_file_line = fl_value > 0;
       }
 
+      if (strcmp(two_state, "") != 0)
+	    two_state_mode = strtol(two_state, 0, 0) > 0;
+
 #ifdef HAVE_FOPEN64
       vvp_out = fopen64(path, "w");
 #else
@@ -211,6 +219,9 @@ int target_design(ivl_design_t des)
       fprintf(vvp_out, ":ivl_delay_selection \"%s\";\n",
                        ivl_design_delay_sel(des));
 
+      if (two_state_mode)
+	    fprintf(vvp_out, ":ivl_two_state;\n");
+
       { int pre = ivl_design_time_precision(des);
 	char sign = '+';
 	if (pre < 0) {
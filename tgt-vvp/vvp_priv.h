@@ -44,6 +44,13 @@ extern unsigned transient_id;
  */
 extern unsigned show_file_line;
 
+/*
+ * Set to non-zero when the design is compiled in two-state mode
+ * (-ptwo_state=1). The 4-state variables and nets are then drawn as
+ * 2-state objects.
+ */
+extern unsigned two_state_mode;
+
 struct vector_info {
       unsigned base;
       unsigned wid;
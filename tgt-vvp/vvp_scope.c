@@ -513,6 +513,12 @@ static void draw_reg_in_scope(ivl_signal_t sig)
 	    datatype_flag = "/obj";
 	    vector_dims = 0;
 	    break;
+	  case IVL_VT_LOGIC:
+	      /* In two-state mode the 4-state variables are drawn as
+		 2-state variables, except in automatic scopes. */
+	    if (two_state_mode && !ivl_scope_is_auto(ivl_signal_scope(sig)))
+		  datatype_flag = ivl_signal_signed(sig)? "/2s" : "/2u";
+	    break;
 	  default:
 	    break;
       }
@@ -618,6 +624,10 @@ static void draw_net_in_scope(ivl_signal_t sig)
 	  case IVL_VT_REAL:
 	    datatype_flag = "/real";
 	    break;
+	  case IVL_VT_LOGIC:
+	    if (two_state_mode)
+		  datatype_flag = ivl_signal_signed(sig)? "/2s" : "/2u";
+	    break;
 	  default:
 	    break;
       }
@@ -645,6 +655,18 @@ static void draw_net_in_scope(ivl_signal_t sig)
 		  if (strength_aware_flag)
 			vec8 = "8";
 
+		    /* There is no Z in two-state mode, so there is no
+		       way to resolve several drivers. */
+		  if (two_state_mode && nex_data->drivers_count > 1) {
+			fprintf(stderr, "%s:%u: vvp.tgt error: net \"%s\" has "
+				"%u drivers. Nets with more than one driver "
+				"are not supported in two-state mode.\n",
+				ivl_signal_file(sig), ivl_signal_lineno(sig),
+				ivl_signal_basename(sig),
+				nex_data->drivers_count);
+			vvp_errors += 1;
+		  }
+
 		  if (iword == 0 && dimensions > 0) {
 			unsigned swapped = ivl_signal_array_addr_swapped(sig);
 			int last = ivl_signal_array_base(sig) + word_count-1;
@@ -944,6 +966,28 @@ static void draw_equiv_impl_in_scope(ivl_net_logic_t lptr)
       fprintf(vvp_out, "L_%p .functor %s 1, %s, %s, C4<0>, C4<0>;\n", lptr, ltype, lval, rval);
 }
 
+/*
+ * Return the name of the logic type if it is one of the gates that
+ * can drive a Z value, or nil otherwise.
+ */
+static const char* logic_z_driver_name(ivl_logic_t type)
+{
+      switch (type) {
+	  case IVL_LO_BUFIF0: return "bufif0";
+	  case IVL_LO_BUFIF1: return "bufif1";
+	  case IVL_LO_BUFT:   return "tri-state buffer";
+	  case IVL_LO_CMOS:   return "cmos";
+	  case IVL_LO_NMOS:   return "nmos";
+	  case IVL_LO_NOTIF0: return "notif0";
+	  case IVL_LO_NOTIF1: return "notif1";
+	  case IVL_LO_PMOS:   return "pmos";
+	  case IVL_LO_RCMOS:  return "rcmos";
+	  case IVL_LO_RNMOS:  return "rnmos";
+	  case IVL_LO_RPMOS:  return "rpmos";
+	  default:            return 0;
+      }
+}
+
 static void draw_logic_in_scope(ivl_net_logic_t lptr)
 {
       unsigned pdx;
@@ -963,6 +1007,18 @@ static void draw_logic_in_scope(ivl_net_logic_t lptr)
       unsigned ninp;
       const char **input_strings;
 
+	/* There is no Z in two-state mode. */
+      if (two_state_mode) {
+	    const char*name = logic_z_driver_name(ivl_logic_type(lptr));
+	    if (name) {
+		  fprintf(stderr, "%s:%u: vvp.tgt error: A %s can drive Z, "
+			  "which is not supported in two-state mode.\n",
+			  ivl_logic_file(lptr), ivl_logic_lineno(lptr), name);
+		  vvp_errors += 1;
+		  return;
+	    }
+      }
+
       switch (ivl_logic_type(lptr)) {
 
           case IVL_LO_UDP:
@@ -26,6 +26,7 @@
 # include  <cmath> // Needed to get pow for as_double().
 # include  <cstdio> // Needed to get snprintf for as_string().
 # include  <algorithm>
+# include  <vector>
 
 using namespace std;
 
@@ -47,17 +48,141 @@ extern "C" long int lround(double x)
 static verinum::V add_with_carry(verinum::V l, verinum::V r, verinum::V&c);
 
 verinum::verinum()
-: bits_(0), nbits_(0), has_len_(false), has_sign_(false), is_single_(false), string_flag_(false)
+: abits_(0), bbits_(0), nbits_(0), has_len_(false), has_sign_(false), is_single_(false), string_flag_(false)
 {
 }
 
 verinum::verinum(const V*bits, unsigned nbits, bool has_len__)
 : has_len_(has_len__), has_sign_(false), is_single_(false), string_flag_(false)
 {
-      nbits_ = nbits;
-      bits_ = new V [nbits];
+      alloc_(nbits);
       for (unsigned idx = 0 ;  idx < nbits ;  idx += 1) {
-	    bits_[idx] = bits[idx];
+	    set(idx, bits[idx]);
+      }
+}
+
+/*
+ * Return the 64 bits of the plane starting at bit off. Bits past the
+ * end of the plane are 0.
+ */
+static uint64_t get_bits64(const uint64_t*plane, unsigned nwords, unsigned off)
+{
+      unsigned widx = off / 64;
+      unsigned sh = off % 64;
+      if (widx >= nwords)
+	    return 0;
+
+      uint64_t val = plane[widx] >> sh;
+      if (sh && (widx+1 < nwords))
+	    val |= plane[widx+1] << (64-sh);
+      return val;
+}
+
+/*
+ * Write the low cnt (at most 64) bits of val into the plane,
+ * starting at bit off.
+ */
+static void put_bits(uint64_t*plane, unsigned off, unsigned cnt, uint64_t val)
+{
+      unsigned widx = off / 64;
+      unsigned sh = off % 64;
+      uint64_t mask = (cnt < 64)? (((uint64_t)1 << cnt) - 1) : ~(uint64_t)0;
+      val &= mask;
+
+      plane[widx] = (plane[widx] & ~(mask << sh)) | (val << sh);
+      if (sh && (sh + cnt > 64)) {
+	    plane[widx+1] = (plane[widx+1] & ~(mask >> (64-sh)))
+		  | (val >> (64-sh));
+      }
+}
+
+void verinum::alloc_(unsigned nbits)
+{
+      nbits_ = nbits;
+      unsigned nwords = nwords_(nbits);
+      if (nwords == 0) {
+	    abits_ = 0;
+	    bbits_ = 0;
+	    return;
+      }
+
+      abits_ = new uint64_t[2*nwords];
+      bbits_ = abits_ + nwords;
+      for (unsigned idx = 0 ;  idx < 2*nwords ;  idx += 1)
+	    abits_[idx] = 0;
+}
+
+/*
+ * Clear the bits of the top word that are past the end of the
+ * number.
+ */
+void verinum::mask_top_()
+{
+      unsigned rem = nbits_ % 64;
+      if (rem == 0)
+	    return;
+
+      uint64_t mask = ((uint64_t)1 << rem) - 1;
+      abits_[nbits_/64] &= mask;
+      bbits_[nbits_/64] &= mask;
+}
+
+uint64_t verinum::aword_(unsigned widx, V pad) const
+{
+      uint64_t fill = (pad == V1 || pad == Vx)? ~(uint64_t)0 : 0;
+      unsigned nwords = nwords_(nbits_);
+      if (widx >= nwords)
+	    return fill;
+
+      uint64_t val = abits_[widx];
+      if ((widx+1 == nwords) && (nbits_ % 64))
+	    val |= fill << (nbits_ % 64);
+      return val;
+}
+
+uint64_t verinum::bword_(unsigned widx, V pad) const
+{
+      uint64_t fill = (pad == Vx || pad == Vz)? ~(uint64_t)0 : 0;
+      unsigned nwords = nwords_(nbits_);
+      if (widx >= nwords)
+	    return fill;
+
+      uint64_t val = bbits_[widx];
+      if ((widx+1 == nwords) && (nbits_ % 64))
+	    val |= fill << (nbits_ % 64);
+      return val;
+}
+
+void verinum::copy_bits_(unsigned dst_off, const verinum&src,
+			 unsigned src_off, unsigned cnt)
+{
+      if (&src == this) {
+	    verinum tmp (src);
+	    copy_bits_(dst_off, tmp, src_off, cnt);
+	    return;
+      }
+
+      assert(dst_off + cnt <= nbits_);
+      assert(src_off + cnt <= src.nbits_);
+      unsigned src_words = nwords_(src.nbits_);
+      for (unsigned idx = 0 ;  idx < cnt ;  idx += 64) {
+	    unsigned trans = min(64U, cnt - idx);
+	    put_bits(abits_, dst_off+idx, trans,
+		     get_bits64(src.abits_, src_words, src_off+idx));
+	    put_bits(bbits_, dst_off+idx, trans,
+		     get_bits64(src.bbits_, src_words, src_off+idx));
+      }
+}
+
+void verinum::fill_bits_(unsigned off, unsigned cnt, V val)
+{
+      assert(off + cnt <= nbits_);
+      uint64_t afill = (val == V1 || val == Vx)? ~(uint64_t)0 : 0;
+      uint64_t bfill = (val == Vx || val == Vz)? ~(uint64_t)0 : 0;
+      for (unsigned idx = 0 ;  idx < cnt ;  idx += 64) {
+	    unsigned trans = min(64U, cnt - idx);
+	    put_bits(abits_, off+idx, trans, afill);
+	    put_bits(bbits_, off+idx, trans, bfill);
       }
 }
 
@@ -151,57 +276,35 @@ verinum::verinum(const string&s)
 : has_len_(true), has_sign_(false), is_single_(false), string_flag_(true)
 {
       string str = process_verilog_string_quotes(s);
-      nbits_ = str.length() * 8;
 
 	// Special case: The string "" is 8 bits of 0.
-      if (nbits_ == 0) {
-	    nbits_ = 8;
-	    bits_ = new V [nbits_];
-	    bits_[0] = V0;
-	    bits_[1] = V0;
-	    bits_[2] = V0;
-	    bits_[3] = V0;
-	    bits_[4] = V0;
-	    bits_[5] = V0;
-	    bits_[6] = V0;
-	    bits_[7] = V0;
+      if (str.length() == 0) {
+	    alloc_(8);
 	    return;
       }
 
-      bits_ = new V [nbits_];
+      alloc_(str.length() * 8);
 
+	// The first character is the most significant byte.
       unsigned idx, cp;
-      V*bp = bits_+nbits_;
-      for (idx = nbits_, cp = 0 ;  idx > 0 ;  idx -= 8, cp += 1) {
-	    char ch = str[cp];
-	    *(--bp) = (ch&0x80) ? V1 : V0;
-	    *(--bp) = (ch&0x40) ? V1 : V0;
-	    *(--bp) = (ch&0x20) ? V1 : V0;
-	    *(--bp) = (ch&0x10) ? V1 : V0;
-	    *(--bp) = (ch&0x08) ? V1 : V0;
-	    *(--bp) = (ch&0x04) ? V1 : V0;
-	    *(--bp) = (ch&0x02) ? V1 : V0;
-	    *(--bp) = (ch&0x01) ? V1 : V0;
-      }
+      for (idx = nbits_, cp = 0 ;  idx > 0 ;  idx -= 8, cp += 1)
+	    put_bits(abits_, idx-8, 8, (unsigned char)str[cp]);
 }
 
 verinum::verinum(verinum::V val, unsigned n, bool h)
 : has_len_(h), has_sign_(false), is_single_(false), string_flag_(false)
 {
-      nbits_ = n;
-      bits_ = new V[nbits_];
-      for (unsigned idx = 0 ;  idx < nbits_ ;  idx += 1)
-	    bits_[idx] = val;
+      alloc_(n);
+      fill_bits_(0, n, val);
 }
 
 verinum::verinum(uint64_t val, unsigned n)
 : has_len_(true), has_sign_(false), is_single_(false), string_flag_(false)
 {
-      nbits_ = n;
-      bits_ = new V[nbits_];
-      for (unsigned idx = 0 ;  idx < nbits_ ;  idx += 1) {
-	    bits_[idx] = (val&1) ? V1 : V0;
-	    val >>= (uint64_t)1;
+      alloc_(n);
+      if (n > 0) {
+	    abits_[0] = val;
+	    mask_top_();
       }
 }
 
@@ -217,9 +320,8 @@ verinum::verinum(double val, bool)
 
 	/* We return `bx for a NaN or +/- infinity. */
       if (val != val || (val && (val == 0.5*val))) {
-	    nbits_ = 1;
-	    bits_ = new V[nbits_];
-	    bits_[0] = Vx;
+	    alloc_(1);
+	    set(0, Vx);
 	    return;
       }
 
@@ -235,15 +337,14 @@ verinum::verinum(double val, bool)
 
 	/* Get the exponent and fractional part of the number. */
       fraction = frexp(val, &exponent);
-      nbits_ = exponent+1;
-      bits_ = new V[nbits_];
+      alloc_(exponent+1);
 
 	/* If the value is small enough just use lround(). */
       if (nbits_ <= BITS_IN_LONG) {
 	    long sval = lround(val);
 	    if (is_neg) sval = -sval;
 	    for (unsigned idx = 0; idx < nbits_; idx += 1) {
-		  bits_[idx] = (sval&1) ? V1 : V0;
+		  set(idx, (sval&1) ? V1 : V0);
 		  sval >>= 1;
 	    }
 	      /* Trim the result. */
@@ -259,7 +360,7 @@ verinum::verinum(double val, bool)
 	    unsigned long bits = (unsigned long) fraction;
 	    fraction = fraction - (double) bits;
 	    for (unsigned idx = 0; idx < nbits_; idx += 1) {
-		  bits_[idx] = (bits&1) ? V1 : V0;
+		  set(idx, (bits&1) ? V1 : V0);
 		  bits >>= 1;
 	    }
       } else {
@@ -269,7 +370,7 @@ verinum::verinum(double val, bool)
 		  unsigned max_idx = (wd+1)*BITS_IN_LONG;
 		  if (max_idx > nbits_) max_idx = nbits_;
 		  for (unsigned idx = wd*BITS_IN_LONG; idx < max_idx; idx += 1) {
-			bits_[idx] = (bits&1) ? V1 : V0;
+			set(idx, (bits&1) ? V1 : V0);
 			bits >>= 1;
 		  }
 		  fraction = ldexp(fraction, BITS_IN_LONG);
@@ -292,43 +393,40 @@ void verinum::signed_trim()
 {
 	/* Do we have any extra digits? */
       unsigned tlen = nbits_-1;
-      verinum::V sign = bits_[tlen];
-      while ((tlen > 0) && (bits_[tlen] == sign)) tlen -= 1;
+      verinum::V sign = get(tlen);
+      while ((tlen > 0) && (get(tlen) == sign)) tlen -= 1;
 
 	/* tlen now points to the first digit that is not the sign.
 	 * or bit 0. Set the length to include this bit and one proper
 	 * sign bit if needed. */
-      if (bits_[tlen] != sign) tlen += 1;
+      if (get(tlen) != sign) tlen += 1;
       tlen += 1;
 
-	/* Trim the bits if needed. */
+	/* Trim the bits if needed. The storage is left as it is. */
       if (tlen < nbits_) {
-	    V* tbits = new V[tlen];
-	    for (unsigned idx = 0; idx < tlen; idx += 1)
-		  tbits[idx] = bits_[idx];
-	    delete[] bits_;
-	    bits_ = tbits;
 	    nbits_ = tlen;
+	    mask_top_();
       }
 }
 
 verinum::verinum(const verinum&that)
 {
       string_flag_ = that.string_flag_;
-      nbits_ = that.nbits_;
-      bits_ = new V[nbits_];
+      alloc_(that.nbits_);
       has_len_ = that.has_len_;
       has_sign_ = that.has_sign_;
       is_single_ = that.is_single_;
-      for (unsigned idx = 0 ;  idx < nbits_ ;  idx += 1)
-	    bits_[idx] = that.bits_[idx];
+      unsigned nwords = nwords_(nbits_);
+      for (unsigned idx = 0 ;  idx < nwords ;  idx += 1) {
+	    abits_[idx] = that.abits_[idx];
+	    bbits_[idx] = that.bbits_[idx];
+      }
 }
 
 verinum::verinum(const verinum&that, unsigned nbits)
 {
       string_flag_ = that.string_flag_ && (that.nbits_ == nbits);
-      nbits_ = nbits;
-      bits_ = new V[nbits_];
+      alloc_(nbits);
       has_len_ = true;
       has_sign_ = that.has_sign_;
       is_single_ = false;
@@ -336,16 +434,11 @@ verinum::verinum(const verinum&that, unsigned nbits)
       unsigned copy = nbits;
       if (copy > that.nbits_)
 	    copy = that.nbits_;
-      for (unsigned idx = 0 ;  idx < copy ;  idx += 1)
-	    bits_[idx] = that.bits_[idx];
+      copy_bits_(0, that, 0, copy);
 
       if (copy < nbits_) {
 	    if (has_sign_ || that.is_single_) {
-		  for (unsigned idx = copy ;  idx < nbits_ ;  idx += 1)
-			bits_[idx] = bits_[idx-1];
-	    } else {
-		  for (unsigned idx = copy ;  idx < nbits_ ;  idx += 1)
-			bits_[idx] = verinum::V0;
+		  fill_bits_(copy, nbits_-copy, get(copy-1));
 	    }
       }
 }
@@ -357,36 +450,38 @@ verinum::verinum(int64_t that)
 
       if (that < 0) tmp = (that+1)/2;
       else tmp = that/2;
-      nbits_ = 1;
+      unsigned nbits = 1;
       while (tmp != 0) {
-	    nbits_ += 1;
+	    nbits += 1;
 	    tmp /= 2;
       }
 
-      nbits_ += 1;
+      nbits += 1;
 
-      bits_ = new V[nbits_];
-      for (unsigned idx = 0 ;  idx < nbits_ ;  idx += 1) {
-	    bits_[idx] = (that & 1)? V1 : V0;
-	    that >>= 1;
-      }
+      alloc_(nbits);
+      abits_[0] = (uint64_t)that;
+      if (nbits > 64)
+	    fill_bits_(64, nbits-64, (that < 0)? V1 : V0);
+      mask_top_();
 }
 
 verinum::~verinum()
 {
-      delete[]bits_;
+      delete[]abits_;
 }
 
 verinum& verinum::operator= (const verinum&that)
 {
       if (this == &that) return *this;
       if (nbits_ != that.nbits_) {
-            delete[]bits_;
-            nbits_ = that.nbits_;
-            bits_ = new V[that.nbits_];
+            delete[]abits_;
+            alloc_(that.nbits_);
+      }
+      unsigned nwords = nwords_(nbits_);
+      for (unsigned idx = 0 ;  idx < nwords ;  idx += 1) {
+	    abits_[idx] = that.abits_[idx];
+	    bbits_[idx] = that.bbits_[idx];
       }
-      for (unsigned idx = 0 ;  idx < nbits_ ;  idx += 1)
-	    bits_[idx] = that.bits_[idx];
 
       has_len_ = that.has_len_;
       has_sign_ = that.has_sign_;
@@ -398,57 +493,48 @@ verinum& verinum::operator= (const verinum&that)
 verinum::V verinum::get(unsigned idx) const
 {
       assert(idx < nbits_);
-      return bits_[idx];
+      uint64_t mask = (uint64_t)1 << (idx % 64);
+      bool abit = (abits_[idx/64] & mask) != 0;
+      if (bbits_[idx/64] & mask)
+	    return abit? Vx : Vz;
+      else
+	    return abit? V1 : V0;
 }
 
 verinum::V verinum::set(unsigned idx, verinum::V val)
 {
       assert(idx < nbits_);
-      return bits_[idx] = val;
+      uint64_t mask = (uint64_t)1 << (idx % 64);
+      if (val == V1 || val == Vx)
+	    abits_[idx/64] |= mask;
+      else
+	    abits_[idx/64] &= ~mask;
+      if (val == Vx || val == Vz)
+	    bbits_[idx/64] |= mask;
+      else
+	    bbits_[idx/64] &= ~mask;
+      return val;
 }
 
 void verinum::set(unsigned off, const verinum&val)
 {
       assert(off + val.len() <= nbits_);
-      for (unsigned idx = 0 ; idx < val.len() ; idx += 1)
-	    bits_[off+idx] = val[idx];
+      copy_bits_(off, val, 0, val.len());
 }
 
 unsigned verinum::as_unsigned() const
 {
-      if (nbits_ == 0)
-	    return 0;
-
-      if (!is_defined())
-	    return 0;
-
-      unsigned val = 0;
-      unsigned mask = 1;
-      for (unsigned idx = 0 ;  idx < nbits_ ;  idx += 1, mask <<= 1)
-	    if (bits_[idx] == V1) {
-		  if (mask == 0) return ~mask;
-		  val |= mask;
-	    }
-
+      uint64_t val = as_ulong64();
+      if (val > UINT_MAX)
+	    return UINT_MAX;
       return val;
 }
 
 unsigned long verinum::as_ulong() const
 {
-      if (nbits_ == 0)
-	    return 0;
-
-      if (!is_defined())
-	    return 0;
-
-      unsigned long val = 0;
-      unsigned long mask = 1;
-      for (unsigned idx = 0 ;  idx < nbits_ ;  idx += 1, mask <<= 1)
-	    if (bits_[idx] == V1) {
-		  if (mask == 0) return ~mask;
-		  val |= mask;
-	    }
-
+      uint64_t val = as_ulong64();
+      if (val > ULONG_MAX)
+	    return ULONG_MAX;
       return val;
 }
 
@@ -460,15 +546,11 @@ uint64_t verinum::as_ulong64() const
       if (!is_defined())
 	    return 0;
 
-      uint64_t val = 0;
-      uint64_t mask = 1;
-      for (unsigned idx = 0 ;  idx < nbits_ ;  idx += 1, mask <<= 1)
-	    if (bits_[idx] == V1) {
-		  if (mask == 0) return ~mask;
-		  val |= mask;
-	    }
+	// If the value does not fit, return the largest value.
+      for (unsigned idx = 1 ;  idx < nwords_(nbits_) ;  idx += 1)
+	    if (abits_[idx]) return ~(uint64_t)0;
 
-      return val;
+      return abits_[0];
 }
 
 /*
@@ -501,26 +583,26 @@ signed long verinum::as_long() const
       }
       int lost_bits=0;
 
-      if (has_sign_ && (bits_[nbits_-1] == V1)) {
+      if (has_sign_ && (get(nbits_-1) == V1)) {
 	    val = -1;
 	    signed long mask = ~1L;
 	    for (unsigned idx = 0 ;  idx < top ;  idx += 1) {
-		  if (bits_[idx] == V0) val &= mask;
+		  if (get(idx) == V0) val &= mask;
 		  mask = (mask << 1) | 1L;
 	    }
 	    if (diag_top) {
 		  for (unsigned idx = top; idx < diag_top; idx += 1) {
-			if (bits_[idx] == V0) lost_bits=1;
+			if (get(idx) == V0) lost_bits=1;
 		  }
 	    }
       } else {
 	    signed long mask = 1;
 	    for (unsigned idx = 0 ;  idx < top ;  idx += 1, mask <<= 1) {
-		  if (bits_[idx] == V1) val |= mask;
+		  if (get(idx) == V1) val |= mask;
 	    }
 	    if (diag_top) {
 		  for (unsigned idx = top; idx < diag_top; idx += 1) {
-			if (bits_[idx] == V1) lost_bits=1;
+			if (get(idx) == V1) lost_bits=1;
 		  }
 	    }
       }
@@ -537,17 +619,17 @@ double verinum::as_double() const
 
       double val = 0.0;
         /* Do we have/want a signed value? */
-      if (has_sign_ && bits_[nbits_-1] == V1) {
+      if (has_sign_ && get(nbits_-1) == V1) {
 	    V carry = V1;
 	    for (unsigned idx = 0; idx < nbits_; idx += 1) {
-		  V sum = add_with_carry(~bits_[idx], V0, carry);
+		  V sum = add_with_carry(~get(idx), V0, carry);
 		  if (sum == V1)
 			val += pow(2.0, (double)idx);
 	    }
 	    val *= -1.0;
       } else {
 	    for (unsigned idx = 0; idx < nbits_; idx += 1) {
-		  if (bits_[idx] == V1)
+		  if (get(idx) == V1)
 			val += pow(2.0, (double)idx);
 	    }
       }
@@ -561,18 +643,12 @@ string verinum::as_string() const
 	    return "";
 
       string res;
+      unsigned nwords = nwords_(nbits_);
       for (unsigned idx = nbits_ ;  idx > 0 ;  idx -= 8) {
-	    char char_val = 0;
-	    V*bp = bits_+idx;
-
-	    if (*(--bp) == V1) char_val |= 0x80;
-	    if (*(--bp) == V1) char_val |= 0x40;
-	    if (*(--bp) == V1) char_val |= 0x20;
-	    if (*(--bp) == V1) char_val |= 0x10;
-	    if (*(--bp) == V1) char_val |= 0x08;
-	    if (*(--bp) == V1) char_val |= 0x04;
-	    if (*(--bp) == V1) char_val |= 0x02;
-	    if (*(--bp) == V1) char_val |= 0x01;
+	      // Only the bits that are 1 (not x) are set in the char.
+	    uint64_t abyte = get_bits64(abits_, nwords, idx-8);
+	    uint64_t bbyte = get_bits64(bbits_, nwords, idx-8);
+	    char char_val = (char)(abyte & ~bbyte & 0xff);
 
 	    if (char_val == '"' || char_val == '\\') {
 		  char tmp[5];
@@ -595,32 +671,31 @@ bool verinum::is_before(const verinum&that) const
       if (that.nbits_ < nbits_) return false;
 
       for (unsigned idx = nbits_  ;  idx > 0 ;  idx -= 1) {
-	    if (bits_[idx-1] < that.bits_[idx-1]) return true;
-	    if (bits_[idx-1] > that.bits_[idx-1]) return false;
+	    if (get(idx-1) < that.get(idx-1)) return true;
+	    if (get(idx-1) > that.get(idx-1)) return false;
       }
       return false;
 }
 
 bool verinum::is_defined() const
 {
-      for (unsigned idx = 0 ;  idx < nbits_ ;  idx += 1) {
-	    if (bits_[idx] == Vx) return false;
-	    if (bits_[idx] == Vz) return false;
+      for (unsigned idx = 0 ;  idx < nwords_(nbits_) ;  idx += 1) {
+	    if (bbits_[idx]) return false;
       }
       return true;
 }
 
 bool verinum::is_zero() const
 {
-      for (unsigned idx = 0 ;  idx < nbits_ ;  idx += 1)
-	    if (bits_[idx] != V0) return false;
+      for (unsigned idx = 0 ;  idx < nwords_(nbits_) ;  idx += 1)
+	    if (abits_[idx] || bbits_[idx]) return false;
 
       return true;
 }
 
 bool verinum::is_negative() const
 {
-      return (bits_[nbits_-1] == V1) && has_sign();
+      return (get(nbits_-1) == V1) && has_sign();
 }
 
 unsigned verinum::significant_bits() const
@@ -628,11 +703,11 @@ unsigned verinum::significant_bits() const
       unsigned sbits = nbits_;
 
       if (has_sign_) {
-	    V sgn_bit = bits_[sbits-1];
-	    while ((sbits > 1) && (bits_[sbits-2] == sgn_bit))
+	    V sgn_bit = get(sbits-1);
+	    while ((sbits > 1) && (get(sbits-2) == sgn_bit))
 		  sbits -= 1;
       } else {
-	    while ((sbits > 1) && (bits_[sbits-1] == verinum::V0))
+	    while ((sbits > 1) && (get(sbits-1) == verinum::V0))
 		  sbits -= 1;
       }
       return sbits;
@@ -640,9 +715,10 @@ unsigned verinum::significant_bits() const
 
 void verinum::cast_to_int2()
 {
-      for (unsigned idx = 0 ;  idx < nbits_ ;  idx += 1) {
-	    if (bits_[idx] == Vx || bits_[idx] == Vz)
-		  bits_[idx] = V0;
+	// Both x (1,1) and z (0,1) become 0 (0,0).
+      for (unsigned idx = 0 ;  idx < nwords_(nbits_) ;  idx += 1) {
+	    abits_[idx] &= ~bbits_[idx];
+	    bbits_[idx] = 0;
       }
 }
 
@@ -668,9 +744,7 @@ verinum pad_to_width(const verinum&that, unsigned width)
       }
 
       verinum val(pad, width, that.has_len());
-
-      for (unsigned idx = 0 ;  idx < that.len() ;  idx += 1)
-	    val.set(idx, that[idx]);
+      val.set(0, that);
 
       val.has_sign(that.has_sign());
       if (that.is_string() && (width % 8) == 0) {
@@ -704,9 +778,7 @@ verinum cast_to_width(const verinum&that, unsigned width)
       }
 
       verinum val(pad, width, true);
-
-      for (unsigned idx = 0 ;  idx < that.len() ;  idx += 1)
-	    val.set(idx, that[idx]);
+      val.set(0, that);
 
       val.has_sign(that.has_sign());
       return val;
@@ -771,8 +843,7 @@ verinum trim_vnum(const verinum&that)
 
       verinum tmp (verinum::V0, tlen, false);
       tmp.has_sign(that.has_sign());
-      for (unsigned idx = 0 ;  idx < tmp.len() ;  idx += 1)
-	    tmp.set(idx, that.get(idx));
+      tmp.copy_bits_(0, that, 0, tlen);
 
       return tmp;
 }
@@ -877,10 +948,14 @@ verinum::V operator == (const verinum&left, const verinum&right)
       if (right.len() > max_len)
 	    max_len = right.len();
 
-      for (unsigned idx = 0 ;  idx < max_len ;  idx += 1) {
-	    verinum::V left_bit  = idx < left.len() ? left[idx]  : left_pad;
-	    verinum::V right_bit = idx < right.len()? right[idx] : right_pad;
-	    if (left_bit != right_bit)
+	// Compare the padded planes a word at a time.
+      for (unsigned idx = 0 ;  idx < verinum::nwords_(max_len) ;  idx += 1) {
+	    uint64_t mask = ~(uint64_t)0;
+	    if ((idx+1)*64 > max_len)
+		  mask >>= (idx+1)*64 - max_len;
+	    if ((left.aword_(idx, left_pad) ^ right.aword_(idx, right_pad)) & mask)
+		  return verinum::V0;
+	    if ((left.bword_(idx, left_pad) ^ right.bword_(idx, right_pad)) & mask)
 		  return verinum::V0;
       }
 
@@ -902,6 +977,23 @@ verinum::V operator <= (const verinum&left, const verinum&right)
 		  return verinum::V0;
       }
 
+	// Defined values are compared a word at a time. When the
+	// calculation is signed, the signs are known to be the same
+	// here, so an unsigned compare of the padded words works.
+      if (left.is_defined() && right.is_defined()) {
+	    unsigned max_len = max(left.len(), right.len());
+	    for (unsigned idx = verinum::nwords_(max_len) ;  idx > 0 ;  idx -= 1) {
+		  uint64_t mask = ~(uint64_t)0;
+		  if (idx*64 > max_len)
+			mask >>= idx*64 - max_len;
+		  uint64_t lword = left.aword_(idx-1, left_pad) & mask;
+		  uint64_t rword = right.aword_(idx-1, right_pad) & mask;
+		  if (lword < rword) return verinum::V1;
+		  if (lword > rword) return verinum::V0;
+	    }
+	    return verinum::V1;
+      }
+
       unsigned idx;
       for (idx = left.len() ; idx > right.len() ;  idx -= 1) {
 	    if (left[idx-1] != right_pad) {
@@ -954,6 +1046,21 @@ verinum::V operator < (const verinum&left, const verinum&right)
 		  return verinum::V0;
       }
 
+	// Defined values are compared a word at a time, as in <=.
+      if (left.is_defined() && right.is_defined()) {
+	    unsigned max_len = max(left.len(), right.len());
+	    for (unsigned idx = verinum::nwords_(max_len) ;  idx > 0 ;  idx -= 1) {
+		  uint64_t mask = ~(uint64_t)0;
+		  if (idx*64 > max_len)
+			mask >>= idx*64 - max_len;
+		  uint64_t lword = left.aword_(idx-1, left_pad) & mask;
+		  uint64_t rword = right.aword_(idx-1, right_pad) & mask;
+		  if (lword < rword) return verinum::V1;
+		  if (lword > rword) return verinum::V0;
+	    }
+	    return verinum::V0;
+      }
+
       unsigned idx;
       for (idx = left.len() ; idx > right.len() ;  idx -= 1) {
 	    if (left[idx-1] != right_pad) {
@@ -1038,23 +1145,33 @@ static verinum::V add_with_carry(verinum::V l, verinum::V r, verinum::V&c)
 
 verinum operator ~ (const verinum&left)
 {
+	// 0 and 1 are flipped, and both x and z become x.
       verinum val = left;
-      for (unsigned idx = 0 ;  idx < val.len() ;  idx += 1)
-	    switch (val[idx]) {
-		case verinum::V0:
-		  val.set(idx, verinum::V1);
-		  break;
-		case verinum::V1:
-		  val.set(idx, verinum::V0);
-		  break;
-		default:
-		  val.set(idx, verinum::Vx);
-		  break;
-	    }
+      for (unsigned idx = 0 ;  idx < verinum::nwords_(val.len()) ;  idx += 1)
+	    val.abits_[idx] = ~val.abits_[idx] | val.bbits_[idx];
+      val.mask_top_();
 
       return val;
 }
 
+/*
+ * Add the words of the left and right operands and the carry in,
+ * and write the sum to the result words.
+ */
+static void add_words(uint64_t*res, unsigned nwords,
+		      const uint64_t*lwords, const uint64_t*rwords,
+		      uint64_t carry)
+{
+      for (unsigned idx = 0 ;  idx < nwords ;  idx += 1) {
+	    uint64_t sum = lwords[idx] + rwords[idx];
+	    uint64_t cout = sum < lwords[idx];
+	    sum += carry;
+	    cout |= sum < carry;
+	    res[idx] = sum;
+	    carry = cout;
+      }
+}
+
 /*
  * Addition and subtraction works a bit at a time, from the least
  * significant up to the most significant. The result is signed only
@@ -1067,7 +1184,6 @@ verinum operator + (const verinum&left, const verinum&right)
       const bool has_len_flag = left.has_len() && right.has_len();
       const bool signed_flag = left.has_sign() && right.has_sign();
 
-      unsigned min_len = min(left.len(), right.len());
       unsigned max_len = max(left.len(), right.len());
 
 	// If either the left or right values are undefined, the
@@ -1079,40 +1195,34 @@ verinum operator + (const verinum&left, const verinum&right)
 	    return result;
       }
 
-      verinum::V*val_bits = new verinum::V[max_len+1];
-
-      verinum::V carry = verinum::V0;
-      for (unsigned idx = 0 ;  idx < min_len ;  idx += 1)
-	    val_bits[idx] = add_with_carry(left[idx], right[idx], carry);
-
+	// Add the padded operands a word at a time, keeping one bit
+	// more than the longest operand for the carry out.
       verinum::V rpad = sign_bit(right);
       verinum::V lpad = sign_bit(left);
 
-      if (left.len() > right.len()) {
-
-	    for (unsigned idx = min_len ;  idx < max_len ;  idx += 1)
-		  val_bits[idx] = add_with_carry(left[idx], rpad, carry);
-
-      } else {
-
-	    for (unsigned idx = min_len ;  idx < max_len ;  idx += 1)
-		  val_bits[idx] = add_with_carry(lpad, right[idx], carry);
+      unsigned nwords = verinum::nwords_(max_len+1);
+      vector<uint64_t> lwords (nwords), rwords (nwords);
+      for (unsigned idx = 0 ;  idx < nwords ;  idx += 1) {
+	    lwords[idx] = left.aword_(idx, lpad);
+	    rwords[idx] = right.aword_(idx, rpad);
       }
 
+      verinum result (verinum::V0, max_len+1, has_len_flag);
+      add_words(result.abits_, nwords, &lwords[0], &rwords[0], 0);
+      result.mask_top_();
+
       unsigned len = max_len;
-      if (!has_len_flag) {
-	    val_bits[max_len] = add_with_carry(lpad, rpad, carry);
+      if (!has_len_flag && max_len > 0) {
 	    if (signed_flag) {
-		  if (val_bits[max_len] != val_bits[max_len-1]) len += 1;
+		  if (result.get(max_len) != result.get(max_len-1)) len += 1;
 	    } else {
-		  if (val_bits[max_len] != verinum::V0) len += 1;
+		  if (result.get(max_len) != verinum::V0) len += 1;
 	    }
       }
-      verinum result (val_bits, len, has_len_flag);
+      result.nbits_ = len;
+      result.mask_top_();
       result.has_sign(signed_flag);
 
-      delete[]val_bits;
-
       return result;
 }
 
@@ -1121,7 +1231,6 @@ verinum operator - (const verinum&left, const verinum&right)
       const bool has_len_flag = left.has_len() && right.has_len();
       const bool signed_flag = left.has_sign() && right.has_sign();
 
-      unsigned min_len = min(left.len(), right.len());
       unsigned max_len = max(left.len(), right.len());
 
 	// If either the left or right values are undefined, the
@@ -1133,36 +1242,30 @@ verinum operator - (const verinum&left, const verinum&right)
 	    return result;
       }
 
-      verinum::V*val_bits = new verinum::V[max_len+1];
-
-      verinum::V carry = verinum::V1;
-      for (unsigned idx = 0 ;  idx < min_len ;  idx += 1)
-	    val_bits[idx] = add_with_carry(left[idx], ~right[idx], carry);
-
+	// Subtract by adding the ones complement of the right value
+	// with a carry in.
       verinum::V rpad = sign_bit(right);
       verinum::V lpad = sign_bit(left);
 
-      if (left.len() > right.len()) {
-
-	    for (unsigned idx = min_len ;  idx < max_len ;  idx += 1)
-		  val_bits[idx] = add_with_carry(left[idx], ~rpad, carry);
-
-      } else {
-
-	    for (unsigned idx = min_len ;  idx < max_len ;  idx += 1)
-		  val_bits[idx] = add_with_carry(lpad, ~right[idx], carry);
+      unsigned nwords = verinum::nwords_(max_len+1);
+      vector<uint64_t> lwords (nwords), rwords (nwords);
+      for (unsigned idx = 0 ;  idx < nwords ;  idx += 1) {
+	    lwords[idx] = left.aword_(idx, lpad);
+	    rwords[idx] = ~right.aword_(idx, rpad);
       }
 
+      verinum result (verinum::V0, max_len+1, has_len_flag);
+      add_words(result.abits_, nwords, &lwords[0], &rwords[0], 1);
+      result.mask_top_();
+
       unsigned len = max_len;
-      if (signed_flag && !has_len_flag) {
-	    val_bits[max_len] = add_with_carry(lpad, ~rpad, carry);
-	    if (val_bits[max_len] != val_bits[max_len-1]) len += 1;
+      if (signed_flag && !has_len_flag && max_len > 0) {
+	    if (result.get(max_len) != result.get(max_len-1)) len += 1;
       }
-      verinum result (val_bits, len, has_len_flag);
+      result.nbits_ = len;
+      result.mask_top_();
       result.has_sign(signed_flag);
 
-      delete[]val_bits;
-
       return result;
 }
 
@@ -1181,21 +1284,24 @@ verinum operator - (const verinum&right)
 	    return result;
       }
 
-      verinum::V*val_bits = new verinum::V[len+1];
+      verinum::V rpad = sign_bit(right);
+
+      unsigned nwords = verinum::nwords_(len+1);
+      vector<uint64_t> lwords (nwords, 0), rwords (nwords);
+      for (unsigned idx = 0 ;  idx < nwords ;  idx += 1)
+	    rwords[idx] = ~right.aword_(idx, rpad);
 
-      verinum::V carry = verinum::V1;
-      for (unsigned idx = 0 ;  idx < len ;  idx += 1)
-	    val_bits[idx] = add_with_carry(verinum::V0, ~right[idx], carry);
+      verinum result (verinum::V0, len+1, has_len_flag);
+      add_words(result.abits_, nwords, &lwords[0], &rwords[0], 1);
+      result.mask_top_();
 
-      if (signed_flag && !has_len_flag) {
-	    val_bits[len] = add_with_carry(verinum::V0, ~sign_bit(right), carry);
-	    if (val_bits[len] != val_bits[len-1]) len += 1;
+      if (signed_flag && !has_len_flag && len > 0) {
+	    if (result.get(len) != result.get(len-1)) len += 1;
       }
-      verinum result (val_bits, len, has_len_flag);
+      result.nbits_ = len;
+      result.mask_top_();
       result.has_sign(signed_flag);
 
-      delete[]val_bits;
-
       return result;
 }
 
@@ -1229,23 +1335,34 @@ verinum operator * (const verinum&left, const verinum&right)
       verinum result(verinum::V0, len, has_len_flag);
       result.has_sign(signed_flag);
 
+	// Split the operands, padded to the result width, into 32-bit
+	// digits so that each partial product fits in a 64-bit word.
+      unsigned ndig = (len + 31) / 32;
+      vector<uint64_t> ldig (ndig), rdig (ndig), prod (ndig, 0);
+      verinum::V l_sign = sign_bit(left);
       verinum::V r_sign = sign_bit(right);
-      for (unsigned rdx = 0 ;  rdx < len ;  rdx += 1) {
+      for (unsigned idx = 0 ;  idx < ndig ;  idx += 1) {
+	    unsigned sh = 32 * (idx % 2);
+	    ldig[idx] = (left.aword_(idx/2, l_sign) >> sh) & 0xffffffff;
+	    rdig[idx] = (right.aword_(idx/2, r_sign) >> sh) & 0xffffffff;
+      }
 
-	    verinum::V r_bit = rdx < r_len ? right.get(rdx) : r_sign;
-	    if (r_bit == verinum::V0)
+      for (unsigned rdx = 0 ;  rdx < ndig ;  rdx += 1) {
+	    if (rdig[rdx] == 0)
 		  continue;
 
-	    verinum::V l_sign = sign_bit(left);
-	    verinum::V carry = verinum::V0;
-	    for (unsigned ldx = 0 ;  ldx < (len - rdx) ;  ldx += 1) {
-		  verinum::V l_bit = ldx < l_len ? left[ldx] : l_sign;
-		  result.set(ldx+rdx, add_with_carry(l_bit,
-						     result[rdx+ldx],
-						     carry));
+	    uint64_t carry = 0;
+	    for (unsigned ldx = 0 ;  ldx < (ndig - rdx) ;  ldx += 1) {
+		  uint64_t tmp = ldig[ldx] * rdig[rdx] + prod[ldx+rdx] + carry;
+		  prod[ldx+rdx] = tmp & 0xffffffff;
+		  carry = tmp >> 32;
 	    }
       }
 
+      for (unsigned idx = 0 ;  idx < ndig ;  idx += 1)
+	    result.abits_[idx/2] |= prod[idx] << (32 * (idx % 2));
+      result.mask_top_();
+
       return trim_vnum(result);
 }
 
@@ -1349,8 +1466,8 @@ verinum operator << (const verinum&that, unsigned shift)
       verinum result(verinum::V0, len, has_len_flag);
       result.has_sign(that.has_sign());
 
-      for (unsigned idx = shift ;  idx < len ;  idx += 1)
-	    result.set(idx, that.get(idx - shift));
+      if (shift < len)
+	    result.copy_bits_(shift, that, 0, len - shift);
 
       return trim_vnum(result);
 }
@@ -1374,8 +1491,7 @@ verinum operator >> (const verinum&that, unsigned shift)
       verinum result(sgn_bit, len, has_len_flag);
       result.has_sign(that.has_sign());
 
-      for (unsigned idx = shift ;  idx < that.len() ;  idx += 1)
-	    result.set(idx-shift, that.get(idx));
+      result.copy_bits_(0, that, shift, that.len() - shift);
 
       return trim_vnum(result);
 }
@@ -1611,11 +1727,8 @@ verinum concat(const verinum&left, const verinum&right)
       }
 
       verinum res (verinum::V0, left.len() + right.len());
-      for (unsigned idx = 0 ;  idx < right.len() ;  idx += 1)
-	    res.set(idx, right.get(idx));
-
-      for (unsigned idx = 0 ;  idx < left.len() ;  idx += 1)
-	    res.set(idx+right.len(), left.get(idx));
+      res.set(0, right);
+      res.set(right.len(), left);
 
       return res;
 }
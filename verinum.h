@@ -33,6 +33,12 @@
  * possible values: 0, 1, x or z. The verinum number is store in
  * little-endian format. This means that if the long value is 2b'10,
  * get(0) is 0 and get(1) is 1.
+ *
+ * The bits are packed into two planes of 64-bit words so that the
+ * arithmetic can work a word at a time. Bit n of the number is bit
+ * n%64 of word n/64 in each plane, and the (abits,bbits) pairs are
+ * 0=(0,0), 1=(1,0), z=(0,1) and x=(1,1). Bits of the top word past
+ * the length of the number are always 0 in both planes.
  */
 class verinum {
 
@@ -112,8 +118,35 @@ class verinum {
     private:
       void signed_trim();
 
+	// Word level access for the arithmetic operators.
+      friend verinum operator - (const verinum&);
+      friend verinum operator + (const verinum&, const verinum&);
+      friend verinum operator - (const verinum&, const verinum&);
+      friend verinum operator * (const verinum&, const verinum&);
+      friend verinum operator<< (const verinum&, unsigned);
+      friend verinum operator>> (const verinum&, unsigned);
+      friend verinum operator ~ (const verinum&);
+      friend V operator == (const verinum&, const verinum&);
+      friend V operator <= (const verinum&, const verinum&);
+      friend V operator <  (const verinum&, const verinum&);
+      friend verinum trim_vnum(const verinum&);
+
+      static unsigned nwords_(unsigned nbits) { return (nbits + 63) / 64; }
+      void alloc_(unsigned nbits);
+      void mask_top_();
+	// Return word widx of a plane, with the bits past the end of
+	// the number filled in with the plane bit of pad.
+      uint64_t aword_(unsigned widx, V pad) const;
+      uint64_t bword_(unsigned widx, V pad) const;
+	// Copy cnt bits of src, starting at src_off, to this number
+	// starting at dst_off.
+      void copy_bits_(unsigned dst_off, const verinum&src,
+		      unsigned src_off, unsigned cnt);
+      void fill_bits_(unsigned off, unsigned cnt, V val);
+
     private:
-      V* bits_;
+      uint64_t*abits_;
+      uint64_t*bbits_;
       unsigned nbits_;
       bool has_len_;
       bool has_sign_;
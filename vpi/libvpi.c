@@ -294,6 +294,30 @@ void vpip_set_return_value(int value)
       assert(vpip_routines);
       vpip_routines->set_return_value(value);
 }
+PLI_INT32 vpip_put_array_words(vpiHandle mem, PLI_INT32 addr, PLI_UINT32 count,
+                               const s_vpi_vecval*vals)
+{
+      assert(vpip_routines);
+      return vpip_routines->put_array_words(mem, addr, count, vals);
+}
+PLI_INT32 vpip_get_array_words(vpiHandle mem, PLI_INT32 addr, PLI_UINT32 count,
+                               s_vpi_vecval*vals)
+{
+      assert(vpip_routines);
+      return vpip_routines->get_array_words(mem, addr, count, vals);
+}
+PLI_INT32 vpip_put_values(PLI_UINT32 count, const vpiHandle*handles,
+                          const s_vpi_vecval*vals)
+{
+      assert(vpip_routines);
+      return vpip_routines->put_values(count, handles, vals);
+}
+PLI_INT32 vpip_get_values(PLI_UINT32 count, const vpiHandle*handles,
+                          s_vpi_vecval*vals)
+{
+      assert(vpip_routines);
+      return vpip_routines->get_values(count, handles, vals);
+}
 
 DLLEXPORT PLI_UINT32 vpip_set_callback(vpip_routines_s*routines, PLI_UINT32 version)
 {
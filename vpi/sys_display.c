@@ -960,8 +960,12 @@ static unsigned int get_numeric(char **rtn, const struct strobe_cb_info *info,
 }
 
 /* In many places we can't use the normal str functions since %u and %z
- * can insert NULL characters into the stream. */
-static char *get_display(unsigned int *rtnsz, const struct strobe_cb_info *info)
+ * can insert NULL characters into the stream. The arguments from *first
+ * up to end are formatted. A format string consumes the arguments it
+ * uses, so *first is left at the last argument used. */
+static char *get_display_args(unsigned int *rtnsz,
+                              const struct strobe_cb_info *info,
+                              unsigned int *first, unsigned int end)
 {
   char *result, *fmt, *rtn, *func_name;
   const char *cresult;
@@ -971,7 +975,7 @@ static char *get_display(unsigned int *rtnsz, const struct strobe_cb_info *info)
 
   rtn = strdup("");
   size = 1;
-  for  (idx = 0; idx < info->nitems; idx += 1) {
+  for  (idx = *first; idx < end; idx += 1) {
     vpiHandle item = info->items[idx];
 
     switch (vpi_get(vpiType, item)) {
@@ -1135,9 +1139,16 @@ static char *get_display(unsigned int *rtnsz, const struct strobe_cb_info *info)
   }
   rtn[size-1] = '\0';
   *rtnsz = size - 1;
+  *first = idx - 1;
   return rtn;
 }
 
+static char *get_display(unsigned int *rtnsz, const struct strobe_cb_info *info)
+{
+  unsigned int idx = 0;
+  return get_display_args(rtnsz, info, &idx, info->nitems);
+}
+
 #ifdef BR916_STOPGAP_FIX
 static char br916_hint_issued = 0;
 #endif
@@ -1434,27 +1445,136 @@ static PLI_INT32 sys_strobe_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
  * nets. Note that it is proper to keep the state in static variables
  * because there can only be one monitor at a time pending (even
  * though that monitor may be watching many variables).
+ *
+ * The formatted text of each argument is kept in the monitor_items
+ * array, so that only the arguments that changed need to be formatted
+ * again. A format string and the arguments it uses are formatted as a
+ * group, and the text is kept in the item for the first argument of
+ * the group. A group is formatted again if any of its arguments has
+ * had a value change, or if it uses an argument that does not have a
+ * value change callback (i.e. $time) and so may change at any time.
  */
 
+struct monitor_item {
+	/* The formatted text of the group that starts with this
+	   argument, or nil if this argument does not start a group. */
+      char*text;
+      unsigned int size;
+	/* The last argument used by the group. */
+      unsigned int last;
+	/* Set by the value change callback for this argument. */
+      unsigned char changed;
+	/* Set if the value of this argument only changes when its
+	   value change callback is called. */
+      unsigned char cached;
+};
+
 static struct strobe_cb_info monitor_info = { 0, 0, 0, 0, 0, 0, 0, 0 };
 static vpiHandle *monitor_callbacks = 0;
+static struct monitor_item *monitor_items = 0;
+static char *monitor_line = 0;
+static unsigned int monitor_line_size = 0;
 static int monitor_scheduled = 0;
 static int monitor_enabled = 1;
 
-static PLI_INT32 monitor_cb_2(p_cb_data cb)
+/*
+ * Discard the formatted text of all the arguments. This is needed
+ * when something other than the argument values changes the text
+ * (i.e. $timeformat).
+ */
+static void monitor_flush_items(void)
 {
-      char* result;
-      unsigned int size;
+      unsigned int idx;
 
+      for (idx = 0 ;  idx < monitor_info.nitems ;  idx += 1) {
+	    free(monitor_items[idx].text);
+	    monitor_items[idx].text = 0;
+      }
+}
+
+static int monitor_item_stale(const struct monitor_item*item)
+{
+      const struct monitor_item*cur;
+      const struct monitor_item*last;
+
+      if (item->text == 0) return 1;
+
+      last = monitor_items + item->last;
+      for (cur = item ;  cur <= last ;  cur += 1) {
+	    if (cur->changed || !cur->cached) return 1;
+      }
+
+      return 0;
+}
+
+/*
+ * Format the groups of arguments that may have changed and rebuild
+ * the monitor line if the text of any of them is different.
+ */
+static void monitor_update_line(void)
+{
+      unsigned int idx, cur;
+      int dirty = monitor_line == 0;
+
+      for (idx = 0 ;  idx < monitor_info.nitems ;  idx += 1) {
+	    struct monitor_item*item = monitor_items + idx;
+	    unsigned int first = idx;
+	    char*text;
+	    unsigned int size;
+
+	    if (! monitor_item_stale(item)) {
+		  idx = item->last;
+		  continue;
+	    }
+
+	    text = get_display_args(&size, &monitor_info, &idx, idx + 1);
+
+	    if (item->text && item->last == idx && item->size == size
+	        && memcmp(item->text, text, size) == 0) {
+		  free(text);
+	    } else {
+		  free(item->text);
+		  item->text = text;
+		  item->size = size;
+		  item->last = idx;
+		  dirty = 1;
+	    }
+
+	      /* The other arguments of the group do not start groups. */
+	    for (cur = first + 1 ;  cur <= idx ;  cur += 1) {
+		  free(monitor_items[cur].text);
+		  monitor_items[cur].text = 0;
+	    }
+      }
+
+      for (idx = 0 ;  idx < monitor_info.nitems ;  idx += 1)
+	    monitor_items[idx].changed = 0;
+
+      if (! dirty) return;
+
+      monitor_line_size = 0;
+      for (idx = 0 ;  idx < monitor_info.nitems ;  idx = monitor_items[idx].last + 1)
+	    monitor_line_size += monitor_items[idx].size;
+
+      monitor_line = realloc(monitor_line, monitor_line_size + 1);
+      cur = 0;
+      for (idx = 0 ;  idx < monitor_info.nitems ;  idx = monitor_items[idx].last + 1) {
+	    memcpy(monitor_line + cur, monitor_items[idx].text,
+	           monitor_items[idx].size);
+	    cur += monitor_items[idx].size;
+      }
+      monitor_line[cur] = '\n';
+}
+
+static PLI_INT32 monitor_cb_2(p_cb_data cb)
+{
       (void)cb; /* Parameter is not used. */
 
 	/* Because %u and %z may put embedded NULL characters into the
-	 * returned string strlen() may not match the real size! */
-      result = get_display(&size, &monitor_info);
-      my_mcd_rawwrite(monitor_info.fd_mcd, result, size);
-      my_mcd_rawwrite(monitor_info.fd_mcd, "\n", 1);
+	 * line strlen() may not match the real size! */
+      monitor_update_line();
+      my_mcd_rawwrite(monitor_info.fd_mcd, monitor_line, monitor_line_size + 1);
       monitor_scheduled = 0;
-      free(result);
       return 0;
 }
 
@@ -1463,13 +1583,17 @@ static PLI_INT32 monitor_cb_2(p_cb_data cb)
  * in the simulation. All this function does is schedule the actual
  * display to occur in a ReadOnlySync callback. The monitor_scheduled
  * flag is used to allow only one monitor strobe to be scheduled.
+ *
+ * The argument that changed is marked here, even if the monitor is
+ * off or already scheduled, so that its text is formatted again.
  */
 static PLI_INT32 monitor_cb_1(p_cb_data cause)
 {
       struct t_cb_data cb;
       struct t_vpi_time timerec;
 
-      (void)cause; /* Parameter is not used. */
+      if (cause && cause->user_data)
+	    ((struct monitor_item*)cause->user_data)->changed = 1;
 
       if (monitor_enabled == 0) return 0;
       if (monitor_scheduled) return 0;
@@ -1527,6 +1651,13 @@ static PLI_INT32 sys_monitor_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 	    free(monitor_callbacks);
 	    monitor_callbacks = 0;
 
+	    monitor_flush_items();
+	    free(monitor_items);
+	    monitor_items = 0;
+	    free(monitor_line);
+	    monitor_line = 0;
+	    monitor_line_size = 0;
+
 	    free(monitor_info.filename);
 	    free(monitor_info.items);
 	    monitor_info.items = 0;
@@ -1547,6 +1678,7 @@ static PLI_INT32 sys_monitor_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 
 	/* Attach callbacks to all the parameters that might change. */
       monitor_callbacks = calloc(monitor_info.nitems, sizeof(vpiHandle));
+      monitor_items = calloc(monitor_info.nitems, sizeof(struct monitor_item));
 
       timerec.type = vpiSuppressTime;
       cb.reason = cbValueChange;
@@ -1573,14 +1705,25 @@ static PLI_INT32 sys_monitor_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 		case vpiRealVar:
 		case vpiPartSelect:
 		    /* Monitoring reg and net values involves setting
-		       a callback for value changes. Pass the storage
-		       pointer for the callback itself as user_data so
-		       that the callback can refresh itself. */
-		  cb.user_data = (char*)(monitor_callbacks+idx);
+		       a callback for value changes. Pass the cached
+		       text item as user_data so that the callback can
+		       mark it as changed. */
+		  cb.user_data = (char*)(monitor_items+idx);
 		  cb.obj = monitor_info.items[idx];
 		  monitor_callbacks[idx] = vpi_register_cb(&cb);
+		  monitor_items[idx].cached = monitor_callbacks[idx] != 0;
+		    /* The callback of a part select with a variable
+		       base is on the parent signal, so it misses a
+		       change of the base. Format it every time. */
+		  if (vpi_get(vpiType, monitor_info.items[idx]) == vpiPartSelect
+		      && ! vpi_get(vpiConstantSelect, monitor_info.items[idx]))
+			monitor_items[idx].cached = 0;
 		  break;
 
+		case vpiConstant:
+		case vpiParameter:
+		  monitor_items[idx].cached = 1;
+		  break;
 	    }
       }
 
@@ -1968,6 +2111,9 @@ static PLI_INT32 sys_timeformat_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
             sys_end_of_compile(NULL);
       }
 
+	/* Any %t text kept by $monitor uses the old format. */
+      if (monitor_items) monitor_flush_items();
+
       return 0;
 }
 
@@ -33,6 +33,7 @@
 # include  "ivl_alloc.h"
 
 static int dump_no_date = 0;
+static int dump_parallel = 0;
 static struct fstContext *dump_file = NULL;
 
 static struct t_vpi_time zero_delay = { vpiSimTime, 0, 0, 0.0 };
@@ -394,6 +395,16 @@ static void open_dumpfile(vpiHandle callh)
 	        (lxm_optimum_mode == LXM_BOTH)) {
 		  fstWriterSetRepackOnClose(dump_file, 1);
 	    }
+	      /* Compress and write the value change blocks in a
+	       * separate thread when requested. */
+	    if (dump_parallel) {
+#ifdef HAVE_LIBPTHREAD
+		  fstWriterSetParallelMode(dump_file, 1);
+#else
+		  vpi_printf("FST warning: -fst-parallel is not supported "
+		             "without threads, ignored.\n");
+#endif
+	    }
       }
 }
 
@@ -596,7 +607,8 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 		    /* Add a callback for the signal. */
 		  info = malloc(sizeof(*info));
 
-		  info->time.type = vpiSimTime;
+		    /* The time is not used by variable_cb_1. */
+		  info->time.type = vpiSuppressTime;
 		  info->item  = item;
 		  info->ident = new_ident;
 		  info->scheduled = 0;
@@ -905,6 +917,8 @@ void sys_fst_register(void)
 		  lxm_optimum_mode = LXM_BOTH;
 		} else if (strcmp(vlog_info.argv[idx],"-no-date") == 0) {
 		  dump_no_date = 1;
+		} else if (strcmp(vlog_info.argv[idx],"-fst-parallel") == 0) {
+		  dump_parallel = 1;
 		}
       }
 
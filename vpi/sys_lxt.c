@@ -574,7 +574,8 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 
 		  info = malloc(sizeof(*info));
 
-		  info->time.type = vpiSimTime;
+		    /* Changes are only queued here, so no time. */
+		  info->time.type = vpiSuppressTime;
 		  info->item  = item;
 		  info->sym   = lt_symbol_add(dump_file, ident,
 		                              0 /* array rows */,
@@ -615,7 +616,7 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 	    }
 	    info = malloc(sizeof(*info));
 
-	    info->time.type = vpiSimTime;
+	    info->time.type = vpiSuppressTime;
 	    info->item = item;
 	    info->sym  = lt_symbol_add(dump_file, ident,
 	                               0 /* array rows */,
@@ -23,13 +23,17 @@
 # include  <stdlib.h>
 # include  <stdio.h>
 # include  <assert.h>
-# include  "sys_readmem_lex.h"
+# include  "sys_readmem_scan.h"
 # include  <sys/stat.h>
 # include  "ivl_alloc.h"
 
 char **search_list = NULL;
 unsigned sl_count = 0;
 
+/* The words of a file are stored to (or fetched from) the memory in
+   blocks of this many words. */
+#define MEM_BLOCK_WORDS 4096
+
 static void get_mem_params(vpiHandle argv, vpiHandle callh, const char *name,
                            char **fname, vpiHandle *mitem,
                            vpiHandle *start_item, vpiHandle *stop_item)
@@ -269,9 +273,67 @@ static PLI_INT32 sys_mem_compiletf(ICARUS_VPI_CONST PLI_BYTE8*name)
       return 0;
 }
 
+/*
+ * Get the width of the words of the memory. Ask the memory itself, so
+ * that a handle for a word does not need to be made.
+ */
+static int get_mem_word_width(vpiHandle mitem, int addr)
+{
+      int wwid = vpi_get(_vpiWordSize, mitem);
+      if (wwid <= 0)
+	    wwid = vpi_get(vpiSize, vpi_handle_by_index(mitem, addr));
+      return wwid;
+}
+
+/*
+ * Store the cnt words in the words array to the memory. The first
+ * word goes to address addr, and the rest go to the following
+ * addresses in the addr_incr direction. Store them all with one bulk
+ * call if the memory supports that, otherwise store each word through
+ * its handle.
+ */
+static void put_mem_words(vpiHandle mitem, int addr, int addr_incr,
+                          unsigned cnt, s_vpi_vecval*words, unsigned hwid)
+{
+      s_vpi_value value;
+      unsigned idx;
+
+      if (cnt == 0) return;
+
+	/* Reverse the words so that they go up in address. */
+      if (addr_incr < 0) {
+	    for (idx = 0 ;  idx < cnt/2 ;  idx += 1) {
+		  s_vpi_vecval*lo = words + idx*hwid;
+		  s_vpi_vecval*hi = words + (cnt-1-idx)*hwid;
+		  unsigned wdx;
+		  for (wdx = 0 ;  wdx < hwid ;  wdx += 1) {
+			s_vpi_vecval tmp = lo[wdx];
+			lo[wdx] = hi[wdx];
+			hi[wdx] = tmp;
+		  }
+	    }
+	    addr -= cnt - 1;
+      }
+
+      if (vpip_put_array_words(mitem, addr, cnt, words) == (PLI_INT32)cnt)
+	    return;
+
+      value.format = vpiVectorVal;
+      for (idx = 0 ;  idx < cnt ;  idx += 1) {
+	    vpiHandle word_index = vpi_handle_by_index(mitem, addr + idx);
+	    assert(word_index);
+	    value.value.vector = words + idx*hwid;
+	    vpi_put_value(word_index, &value, 0, vpiNoDelay);
+      }
+}
+
 static PLI_INT32 sys_readmem_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 {
       int code, wwid, addr;
+      unsigned hwid;
+      s_vpi_vecval*words;
+      unsigned run_cnt = 0;
+      int run_addr = 0;
       FILE*file;
       char *fname = 0;
       s_vpi_value value;
@@ -334,26 +396,36 @@ static PLI_INT32 sys_readmem_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 	/* We need this many words from the file. */
       word_count = max_addr-min_addr+1;
 
-      wwid = vpi_get(vpiSize, vpi_handle_by_index(mitem, min_addr));
+      wwid = get_mem_word_width(mitem, min_addr);
+      hwid = (wwid+31)/32;
 
-      /* variable that will be used by the lexer to pass values
+      /* variable that will be used by the scanner to pass values
 	 back to this code */
       value.format = vpiVectorVal;
-      value.value.vector = calloc((wwid+31)/32, sizeof(s_vpi_vecval));
+      value.value.vector = calloc(hwid, sizeof(s_vpi_vecval));
 
-      /* Configure the readmem lexer */
-      if (strcmp(name,"$readmemb") == 0)
-	    sys_readmem_start_file(callh, file, 1, wwid, value.value.vector);
-      else
-	    sys_readmem_start_file(callh, file, 0, wwid, value.value.vector);
+      /* The words are collected here and stored a block at a time. */
+      words = calloc(MEM_BLOCK_WORDS*hwid, sizeof(s_vpi_vecval));
+
+      /* Configure the readmem scanner */
+      if (sys_readmem_start_file(callh, file,
+                                 strcmp(name,"$readmemb") == 0,
+                                 wwid, value.value.vector)) {
+	    vpi_printf("ERROR: %s:%d: ", vpi_get_str(vpiFile, callh),
+	               (int)vpi_get(vpiLineNo, callh));
+	    vpi_printf("%s: Unable to read %s.\n", name, fname);
+	    goto bailout;
+      }
 
       /*======================================== Read memory file */
 
       /* Run through the input file and store the new contents in the memory */
       addr = start_addr;
-      while ((code = readmemlex()) != 0) {
+      while ((code = sys_readmem_scan()) != 0) {
 	  switch (code) {
 	  case MEM_ADDRESS:
+	      put_mem_words(mitem, run_addr, addr_incr, run_cnt, words, hwid);
+	      run_cnt = 0;
 	      addr = value.value.vector->aval;
 	      if (addr < min_addr || addr > max_addr) {
 		  vpi_printf("ERROR: %s:%d: ", vpi_get_str(vpiFile, callh),
@@ -372,10 +444,15 @@ static PLI_INT32 sys_readmem_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 
 	  case MEM_WORD:
 	      if (addr >= min_addr && addr <= max_addr) {
-		  vpiHandle word_index;
-		  word_index = vpi_handle_by_index(mitem, addr);
-		  assert(word_index);
-		  vpi_put_value(word_index, &value, 0, vpiNoDelay);
+		  if (run_cnt == MEM_BLOCK_WORDS) {
+			put_mem_words(mitem, run_addr, addr_incr, run_cnt,
+			              words, hwid);
+			run_cnt = 0;
+		  }
+		  if (run_cnt == 0) run_addr = addr;
+		  memcpy(words + run_cnt*hwid, value.value.vector,
+		         hwid*sizeof(s_vpi_vecval));
+		  run_cnt += 1;
 
 		  if (word_count > 0) word_count -= 1;
 	      } else {
@@ -414,10 +491,12 @@ static PLI_INT32 sys_readmem_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
       }
 
  bailout:
+      put_mem_words(mitem, run_addr, addr_incr, run_cnt, words, hwid);
+      free(words);
       free(value.value.vector);
       free(fname);
       fclose(file);
-      destroy_readmem_lexor();
+      sys_readmem_end_file();
       return 0;
 }
 
@@ -520,6 +599,88 @@ static PLI_INT32 sys_readmempath_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
       return 0;
 }
 
+/*
+ * Format a word in hex (or binary if bin_flag is set) the same way as
+ * the vpiHexStrVal (vpiBinStrVal) value of the word.
+ */
+static void format_mem_word(char*buf, const s_vpi_vecval*word,
+                            unsigned wid, int bin_flag)
+{
+      unsigned bits = bin_flag ? 1 : 4;
+      unsigned ndig = (wid + bits - 1) / bits;
+      unsigned idx;
+
+      for (idx = 0 ;  idx < ndig ;  idx += 1) {
+	    unsigned off = idx * bits;
+	    unsigned cnt = wid - off < bits ? wid - off : bits;
+	    PLI_UINT32 mask = (1U << cnt) - 1;
+	    PLI_UINT32 a = ((PLI_UINT32)word[off/32].aval >> (off%32)) & mask;
+	    PLI_UINT32 b = ((PLI_UINT32)word[off/32].bval >> (off%32)) & mask;
+	    PLI_UINT32 x = a & b;
+	    PLI_UINT32 z = ~a & b;
+	    char ch;
+
+	    if (b == 0)
+		  ch = "0123456789abcdef"[a];
+	    else if (z == mask)
+		  ch = 'z';
+	    else if (x == mask)
+		  ch = 'x';
+	    else if (x == 0)
+		  ch = 'Z';
+	    else
+		  ch = 'X';
+
+	    buf[ndig-1-idx] = ch;
+      }
+      buf[ndig] = 0;
+}
+
+/*
+ * Write the words of the memory a block at a time, using the bulk
+ * fetch of the words. Return 0 if the memory does not support that.
+ */
+static int write_mem_words(FILE*file, vpiHandle mitem, int start_addr,
+                           int addr_incr, unsigned total, int bin_flag)
+{
+      int wwid = get_mem_word_width(mitem, start_addr);
+      unsigned hwid = (wwid+31)/32;
+      s_vpi_vecval*words = calloc(MEM_BLOCK_WORDS*hwid, sizeof(s_vpi_vecval));
+      char*line = malloc(wwid + 2);
+      unsigned cnt = 0;
+      int addr = start_addr;
+
+      while (cnt < total) {
+	    unsigned blk = total - cnt;
+	    unsigned idx;
+	    int low;
+
+	    if (blk > MEM_BLOCK_WORDS) blk = MEM_BLOCK_WORDS;
+	    low = addr_incr > 0 ? addr : addr - (int)(blk - 1);
+
+	    if (vpip_get_array_words(mitem, low, blk, words) != (PLI_INT32)blk) {
+		  assert(cnt == 0);
+		  free(line);
+		  free(words);
+		  return 0;
+	    }
+
+	    for (idx = 0 ;  idx < blk ;  idx += 1, cnt += 1) {
+		  unsigned wdx = addr_incr > 0 ? idx : blk - 1 - idx;
+		  if (cnt%16 == 0) fprintf(file, "// 0x%08x\n", cnt);
+		  format_mem_word(line, words + wdx*hwid, wwid, bin_flag);
+		  fputs(line, file);
+		  fputc('\n', file);
+	    }
+
+	    addr += addr_incr * (int)blk;
+      }
+
+      free(line);
+      free(words);
+      return 1;
+}
+
 static PLI_INT32 sys_writemem_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 {
       int addr;
@@ -534,7 +695,7 @@ static PLI_INT32 sys_writemem_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
       vpiHandle stop_item = 0;
 
       int start_addr, stop_addr, addr_incr;
-      int min_addr, max_addr; // Not used in this routine.
+      int min_addr, max_addr;
 
       /*======================================== Get parameters */
 
@@ -567,6 +728,14 @@ static PLI_INT32 sys_writemem_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 
       /*======================================== Write memory file */
 
+      if (write_mem_words(file, mitem, start_addr, addr_incr,
+                          max_addr - min_addr + 1,
+                          strcmp(name,"$writememb") == 0)) {
+	    fclose(file);
+	    free(fname);
+	    return 0;
+      }
+
       cnt = 0;
       for(addr=start_addr; addr!=stop_addr+addr_incr; addr+=addr_incr, ++cnt) {
 	  vpiHandle word_index;
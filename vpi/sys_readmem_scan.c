@@ -0,0 +1,346 @@
+/*
+ * Copyright (c) 1999-2021 Stephen Williams (steve@icarus.com)
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "vpi_config.h"
+# include  "sys_readmem_scan.h"
+# include  <stdlib.h>
+# include  <string.h>
+#ifndef __MINGW32__
+# include  <sys/types.h>
+# include  <sys/stat.h>
+# include  <sys/mman.h>
+#endif
+# include  "ivl_alloc.h"
+
+/*
+ * This is the scanner for the $readmemh and $readmemb files. The
+ * whole file is mapped (or, if that is not possible, read) into
+ * memory and scanned in place, a token at a time. The tokens are:
+ *
+ *   white space and C or C++ style comments, which are skipped
+ *   @<hex digits>, which is a MEM_ADDRESS
+ *   a run of hex (or binary) digits, x, z and _, which is a MEM_WORD
+ *
+ * Any other character is a MEM_ERROR, and readmem_error_token points
+ * at a string holding that character.
+ */
+
+char *readmem_error_token = 0;
+
+ /* The call_handle is the handle for the call to the $readmem()
+    system task. This is used for adding line numbers to warnings and
+    error messages. */
+static vpiHandle call_handle = 0;
+static int too_many_digits_warning = 0;
+
+static int bin_mode = 0;
+static unsigned word_width = 0;
+static struct t_vpi_vecval*vecval = 0;
+
+static char*file_buf = 0;
+static size_t file_len = 0;
+static int file_mapped = 0;
+static const char*scan_ptr = 0;
+static const char*scan_end = 0;
+static char error_buf[2];
+
+/*
+ * The digit_code table maps each character to its value as a digit,
+ * or to one of the special codes below.
+ */
+enum { DIG_X = 16, DIG_Z = 17, DIG_SKIP = 18, DIG_NONE = 19 };
+static unsigned char hex_code[256];
+static unsigned char bin_code[256];
+
+static void init_digit_codes(void)
+{
+      static int done = 0;
+      int idx;
+
+      if (done) return;
+      done = 1;
+
+      for (idx = 0 ;  idx < 256 ;  idx += 1) {
+	    hex_code[idx] = DIG_NONE;
+	    bin_code[idx] = DIG_NONE;
+      }
+      for (idx = 0 ;  idx < 10 ;  idx += 1)
+	    hex_code['0'+idx] = idx;
+      for (idx = 0 ;  idx < 6 ;  idx += 1) {
+	    hex_code['a'+idx] = 10 + idx;
+	    hex_code['A'+idx] = 10 + idx;
+      }
+      hex_code['x'] = hex_code['X'] = DIG_X;
+      hex_code['z'] = hex_code['Z'] = DIG_Z;
+      hex_code['_'] = DIG_SKIP;
+
+      bin_code['0'] = 0;
+      bin_code['1'] = 1;
+      bin_code['x'] = bin_code['X'] = DIG_X;
+      bin_code['z'] = bin_code['Z'] = DIG_Z;
+      bin_code['_'] = DIG_SKIP;
+}
+
+static void make_addr(const char*beg, const char*end)
+{
+      PLI_UINT64 addr = 0;
+
+      while (beg < end) {
+	    addr = (addr << 4) | hex_code[(unsigned char)*beg];
+	    if (addr > 0xffffffffU) addr = 0xffffffffU;
+	    beg += 1;
+      }
+      vecval->aval = (PLI_INT32)addr;
+      vecval->bval = 0;
+}
+
+/*
+ * Convert the digits of a word, from the least significant end, into
+ * the vecval words. Each digit is 4 bits for $readmemh or 1 bit for
+ * $readmemb.
+ */
+static void make_value(const char*beg, const char*tok_end, unsigned bits)
+{
+      const unsigned char*code = bin_mode ? bin_code : hex_code;
+      const char*end = tok_end;
+      const PLI_UINT32 all = (1U << bits) - 1;
+      struct t_vpi_vecval*cur;
+      int idx;
+      int width = 0, word_max = word_width;
+
+      for (idx = 0, cur = vecval ;  idx < word_max ;  idx += 32, cur += 1) {
+	    cur->aval = 0;
+	    cur->bval = 0;
+      }
+
+      cur = vecval;
+      while ((width < word_max) && (end > beg)) {
+	    PLI_UINT32 aval, bval;
+	    unsigned dig;
+
+	    end -= 1;
+	    dig = code[(unsigned char)*end];
+	    switch (dig) {
+		case DIG_SKIP:
+		  continue;
+		case DIG_X:
+		  aval = all;
+		  bval = all;
+		  break;
+		case DIG_Z:
+		  aval = 0;
+		  bval = all;
+		  break;
+		default:
+		  aval = dig;
+		  bval = 0;
+		  break;
+	    }
+
+	    cur->aval |= aval << width;
+	    cur->bval |= bval << width;
+	    width += bits;
+	    if (width == 32) {
+		  cur += 1;
+		  width = 0;
+		  word_max -= 32;
+	    }
+      }
+
+	/* If there are more text digits then needed to fill the
+	   memory word, count those digits and print a warning
+	   message. Print that warning only once per call to
+	   $readmem() so that the user isn't flooded. */
+      if (too_many_digits_warning == 0) {
+	    int count_extra_digits = 0;
+	    while (end > beg) {
+		  end -= 1;
+		  if (*end == '_') continue;
+		  count_extra_digits += 1;
+	    }
+
+	    if (count_extra_digits) {
+		  size_t len = tok_end - beg;
+		  char*text = malloc(len + 1);
+		  memcpy(text, beg, len);
+		  text[len] = 0;
+		  vpi_printf("WARNING: %s:%d: Excess %s digits (%d of '%s') while reading %d-bit words.\n",
+			     vpi_get_str(vpiFile, call_handle),
+			     (int)vpi_get(vpiLineNo, call_handle),
+			     bin_mode ? "binary" : "hex",
+			     count_extra_digits, text,
+			     word_width);
+		  free(text);
+		  too_many_digits_warning += 1;
+	    }
+      }
+}
+
+int sys_readmem_scan(void)
+{
+      const unsigned char*code = bin_mode ? bin_code : hex_code;
+
+      while (scan_ptr < scan_end) {
+	    const char*beg = scan_ptr;
+
+	    switch (*beg) {
+		case ' ':
+		case '\t':
+		case '\f':
+		case '\n':
+		case '\r':
+		  scan_ptr += 1;
+		  continue;
+
+		case '/':
+		  if (beg+1 < scan_end && beg[1] == '/') {
+			scan_ptr = memchr(beg, '\n', scan_end - beg);
+			if (scan_ptr == 0) scan_ptr = scan_end;
+			continue;
+		  }
+		  if (beg+1 < scan_end && beg[1] == '*') {
+			scan_ptr = beg + 2;
+			for (;;) {
+			      scan_ptr = memchr(scan_ptr, '*',
+			                        scan_end - scan_ptr);
+			      if (scan_ptr == 0 || scan_ptr+1 >= scan_end) {
+				    scan_ptr = scan_end;
+				    break;
+			      }
+			      scan_ptr += 1;
+			      if (*scan_ptr == '/') {
+				    scan_ptr += 1;
+				    break;
+			      }
+			}
+			continue;
+		  }
+		  break;
+
+		case '@':
+		  scan_ptr = beg + 1;
+		  while (scan_ptr < scan_end
+		         && hex_code[(unsigned char)*scan_ptr] < 16)
+			scan_ptr += 1;
+		  if (scan_ptr > beg + 1) {
+			make_addr(beg + 1, scan_ptr);
+			return MEM_ADDRESS;
+		  }
+		  scan_ptr = beg;
+		  break;
+
+		default:
+		  break;
+	    }
+
+	    if (code[(unsigned char)*beg] != DIG_NONE) {
+		  scan_ptr = beg + 1;
+		  while (scan_ptr < scan_end
+		         && code[(unsigned char)*scan_ptr] != DIG_NONE)
+			scan_ptr += 1;
+		  make_value(beg, scan_ptr, bin_mode ? 1 : 4);
+		  return MEM_WORD;
+	    }
+
+	      /* Catch any invalid tokens and flag them as an error. */
+	    error_buf[0] = *beg;
+	    error_buf[1] = 0;
+	    readmem_error_token = error_buf;
+	    scan_ptr = beg + 1;
+	    return MEM_ERROR;
+      }
+
+      return 0;
+}
+
+/*
+ * Map the file into memory. If that is not possible (i.e. the file
+ * is a pipe) read the whole file into a buffer instead.
+ */
+int sys_readmem_start_file(vpiHandle callh, FILE*in, int bin_flag,
+			   unsigned width, struct t_vpi_vecval *vv)
+{
+      init_digit_codes();
+
+      call_handle = callh;
+      too_many_digits_warning = 0;
+      bin_mode = bin_flag;
+      word_width = width;
+      vecval = vv;
+
+      file_buf = 0;
+      file_len = 0;
+      file_mapped = 0;
+
+#ifndef __MINGW32__
+      struct stat sb;
+      if (fstat(fileno(in), &sb) == 0 && S_ISREG(sb.st_mode)
+          && sb.st_size > 0) {
+	    void*map = mmap(0, sb.st_size, PROT_READ, MAP_PRIVATE,
+	                    fileno(in), 0);
+	    if (map != MAP_FAILED) {
+		  file_buf = (char*)map;
+		  file_len = sb.st_size;
+		  file_mapped = 1;
+#ifdef MADV_SEQUENTIAL
+		  madvise(map, file_len, MADV_SEQUENTIAL);
+#endif
+	    }
+      }
+#endif
+
+      if (! file_mapped) {
+	    size_t size = 0x10000;
+	    size_t cnt;
+	    file_buf = malloc(size);
+	    while ((cnt = fread(file_buf + file_len, 1, size - file_len, in)) > 0) {
+		  file_len += cnt;
+		  if (file_len == size) {
+			size *= 2;
+			file_buf = realloc(file_buf, size);
+		  }
+	    }
+	    if (ferror(in)) {
+		  free(file_buf);
+		  file_buf = 0;
+		  file_len = 0;
+		  return 1;
+	    }
+      }
+
+      scan_ptr = file_buf;
+      scan_end = file_buf + file_len;
+      return 0;
+}
+
+void sys_readmem_end_file(void)
+{
+#ifndef __MINGW32__
+      if (file_mapped)
+	    munmap(file_buf, file_len);
+      else
+#endif
+	    free(file_buf);
+
+      file_buf = 0;
+      file_len = 0;
+      file_mapped = 0;
+      scan_ptr = 0;
+      scan_end = 0;
+}
@@ -1,5 +1,5 @@
-#ifndef IVL_sys_readmem_lex_H
-#define IVL_sys_readmem_lex_H
+#ifndef IVL_sys_readmem_scan_H
+#define IVL_sys_readmem_scan_H
 /*
  * Copyright (c) 1999-2014,2019 Stephen Williams (steve@icarus.com)
  *
@@ -28,10 +28,18 @@
 
 extern char *readmem_error_token;
 
-extern void sys_readmem_start_file(vpiHandle callh, FILE*in, int bin_flag,
-				   unsigned width, struct t_vpi_vecval*val);
-extern int readmemlex(void);
+/*
+ * Start scanning the file for $readmemh (bin_flag is 0) or $readmemb
+ * (bin_flag is 1). Each call to sys_readmem_scan() returns the next
+ * token, or 0 at the end of the file. The value of a MEM_WORD token,
+ * or the address of a MEM_ADDRESS token (in aval), is written to the
+ * val array, which must hold enough words for the given width. The
+ * start function returns non-zero if the file cannot be read.
+ */
+extern int sys_readmem_start_file(vpiHandle callh, FILE*in, int bin_flag,
+				  unsigned width, struct t_vpi_vecval*val);
+extern int sys_readmem_scan(void);
 
-extern void destroy_readmem_lexor(void);
+extern void sys_readmem_end_file(void);
 
-#endif /* IVL_sys_readmem_lex_H */
+#endif /* IVL_sys_readmem_scan_H */
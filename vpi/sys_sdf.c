@@ -40,12 +40,20 @@ static char* sdf_fname = NULL;
 
 static vpiHandle find_scope(vpiHandle scope, const char*name)
 {
+	/* vpi_handle_by_name() uses the name index of the scope, so try
+	 * that first. It may also find the scope itself or something
+	 * other than a module, so check what it found, and if it is not
+	 * a module in this scope search for one the long way. */
+      vpiHandle cur = vpi_handle_by_name(name, scope);
+      if (cur && cur != scope && vpi_get(vpiType, cur) == vpiModule
+          && vpi_handle(vpiScope, cur) == scope)
+	    return cur;
+
       vpiHandle idx = vpi_iterate(vpiModule, scope);
 	/* If this scope has no modules then it can't have the one we
 	 * are looking for so just return 0. */
       if (idx == 0) return 0;
 
-      vpiHandle cur;
       while ( (cur = vpi_scan(idx)) ) {
 
 	    if ( strcmp(name, vpi_get_str(vpiName,cur)) == 0) {
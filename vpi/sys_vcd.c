@@ -26,13 +26,18 @@
 
 # include  <stdio.h>
 # include  <stdlib.h>
+# include  <stdarg.h>
 # include  <string.h>
 # include  <assert.h>
 # include  <time.h>
+#ifdef HAVE_LIBPTHREAD
+# include  <pthread.h>
+#endif
 # include  "ivl_alloc.h"
 
 static FILE *dump_file = NULL;
 static int   dump_no_date = 0;
+static int   dump_parallel = 0;
 
 static struct t_vpi_time zero_delay = { vpiSimTime, 0, 0, 0.0 };
 
@@ -87,19 +92,305 @@ static void gen_new_vcd_id(void)
       assert(0);
 }
 
-static char *truncate_bitvec(char *s)
+/*
+ * All the VCD text is collected in a large private buffer, and the
+ * buffer is written to the (unbuffered) dump file when it fills. With
+ * -vcd-parallel a full buffer is instead handed to a writer thread,
+ * and the simulation goes on filling a second buffer while the first
+ * one is written.
+ */
+#define VCD_BUF_SIZE (1024*1024)
+
+static char  *vcd_buf = 0;
+static size_t vcd_buf_used = 0;
+  /* The number of bytes handed to the file so far, for $dumplimit. */
+static long   vcd_buf_written = 0;
+
+#ifdef HAVE_LIBPTHREAD
+static pthread_t       vcd_writer;
+static pthread_mutex_t vcd_writer_lock = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t  vcd_writer_cond = PTHREAD_COND_INITIALIZER;
+static int    vcd_writer_running = 0;
+static int    vcd_writer_stop = 0;
+  /* The buffer that the writer thread owns, and how much of it is
+     still to be written. The thread sets the count to 0 when done. */
+static char  *vcd_wbuf = 0;
+static size_t vcd_wbuf_used = 0;
+
+static void* vcd_writer_thread(void*arg)
+{
+      (void)arg; /* Parameter is not used. */
+
+      pthread_mutex_lock(&vcd_writer_lock);
+      for (;;) {
+	    while (vcd_wbuf_used == 0 && !vcd_writer_stop)
+		  pthread_cond_wait(&vcd_writer_cond, &vcd_writer_lock);
+	    if (vcd_wbuf_used == 0) break;
+
+	    pthread_mutex_unlock(&vcd_writer_lock);
+	    fwrite(vcd_wbuf, 1, vcd_wbuf_used, dump_file);
+	    pthread_mutex_lock(&vcd_writer_lock);
+
+	    vcd_wbuf_used = 0;
+	    pthread_cond_broadcast(&vcd_writer_cond);
+      }
+      pthread_mutex_unlock(&vcd_writer_lock);
+      return 0;
+}
+
+static void vcd_writer_wait(void)
+{
+      pthread_mutex_lock(&vcd_writer_lock);
+      while (vcd_wbuf_used != 0)
+	    pthread_cond_wait(&vcd_writer_cond, &vcd_writer_lock);
+      pthread_mutex_unlock(&vcd_writer_lock);
+}
+#endif
+
+static void vcd_buf_write(void)
 {
-      char r;
+      if (vcd_buf_used == 0) return;
+
+      vcd_buf_written += vcd_buf_used;
+#ifdef HAVE_LIBPTHREAD
+      if (vcd_writer_running) {
+	    char*tmp;
+	    vcd_writer_wait();
+	    pthread_mutex_lock(&vcd_writer_lock);
+	    tmp = vcd_wbuf;
+	    vcd_wbuf = vcd_buf;
+	    vcd_wbuf_used = vcd_buf_used;
+	    vcd_buf = tmp;
+	    pthread_cond_broadcast(&vcd_writer_cond);
+	    pthread_mutex_unlock(&vcd_writer_lock);
+	    vcd_buf_used = 0;
+	    return;
+      }
+#endif
+      fwrite(vcd_buf, 1, vcd_buf_used, dump_file);
+      vcd_buf_used = 0;
+}
 
-      r=*s;
-      if(r=='1') return s;
-      else s += 1;
+/* Write out everything that has been generated so far. */
+static void vcd_buf_flush(void)
+{
+      vcd_buf_write();
+#ifdef HAVE_LIBPTHREAD
+      if (vcd_writer_running) vcd_writer_wait();
+#endif
+      fflush(dump_file);
+}
 
-      for(;;s++) {
-	    char l;
-	    l=r; r=*s;
-	    if(!r) return (s-1);
-	    if(l!=r) return(((l=='0')&&(r=='1'))?s:s-1);
+static void vcd_buf_open(void)
+{
+      setvbuf(dump_file, NULL, _IONBF, 0);
+      vcd_buf = malloc(VCD_BUF_SIZE);
+      vcd_buf_used = 0;
+      vcd_buf_written = 0;
+
+      if (dump_parallel) {
+#ifdef HAVE_LIBPTHREAD
+	    vcd_wbuf = malloc(VCD_BUF_SIZE);
+	    vcd_wbuf_used = 0;
+	    vcd_writer_stop = 0;
+	    if (pthread_create(&vcd_writer, 0, vcd_writer_thread, 0) == 0) {
+		  vcd_writer_running = 1;
+	    } else {
+		  free(vcd_wbuf);
+		  vcd_wbuf = 0;
+	    }
+#else
+	    vpi_printf("VCD warning: -vcd-parallel is not supported "
+	               "without threads, ignored.\n");
+#endif
+      }
+}
+
+static void vcd_buf_close(void)
+{
+      vcd_buf_write();
+#ifdef HAVE_LIBPTHREAD
+      if (vcd_writer_running) {
+	    pthread_mutex_lock(&vcd_writer_lock);
+	    vcd_writer_stop = 1;
+	    pthread_cond_broadcast(&vcd_writer_cond);
+	    pthread_mutex_unlock(&vcd_writer_lock);
+	    pthread_join(vcd_writer, 0);
+	    vcd_writer_running = 0;
+	    free(vcd_wbuf);
+	    vcd_wbuf = 0;
+      }
+#endif
+      free(vcd_buf);
+      vcd_buf = 0;
+}
+
+/* Return a pointer to at least cnt (<= VCD_BUF_SIZE) free bytes. */
+static __inline__ char* vcd_buf_reserve(size_t cnt)
+{
+      if (VCD_BUF_SIZE - vcd_buf_used < cnt) vcd_buf_write();
+      return vcd_buf + vcd_buf_used;
+}
+
+static void vcd_buf_put(const char*str, size_t cnt)
+{
+      while (cnt > 0) {
+	    size_t use = VCD_BUF_SIZE - vcd_buf_used;
+	    if (use == 0) {
+		  vcd_buf_write();
+		  use = VCD_BUF_SIZE;
+	    }
+	    if (use > cnt) use = cnt;
+	    memcpy(vcd_buf + vcd_buf_used, str, use);
+	    vcd_buf_used += use;
+	    str += use;
+	    cnt -= use;
+      }
+}
+
+static void vcd_printf(const char*fmt, ...)
+{
+      size_t room = VCD_BUF_SIZE - vcd_buf_used;
+      va_list ap;
+      int len;
+
+      va_start(ap, fmt);
+      len = vsnprintf(vcd_buf + vcd_buf_used, room, fmt, ap);
+      va_end(ap);
+      assert(len >= 0);
+
+      if ((size_t)len < room) {
+	    vcd_buf_used += len;
+      } else {
+	    char*tmp = malloc(len + 1);
+	    va_start(ap, fmt);
+	    vsnprintf(tmp, len + 1, fmt, ap);
+	    va_end(ap);
+	    vcd_buf_put(tmp, len);
+	    free(tmp);
+      }
+}
+
+static void vcd_put_time(PLI_UINT64 now)
+{
+      char tmp[24];
+      char*cp = tmp + sizeof(tmp);
+      char*dst;
+      size_t len;
+
+      *--cp = '\n';
+      do {
+	    *--cp = '0' + (char)(now % 10);
+	    now /= 10;
+      } while (now);
+      *--cp = '#';
+
+      len = tmp + sizeof(tmp) - cp;
+      dst = vcd_buf_reserve(len);
+      memcpy(dst, cp, len);
+      vcd_buf_used += len;
+}
+
+/*
+ * The bits of a vector value are turned into characters a nibble at
+ * a time. The table is indexed by the bval nibble and the aval nibble
+ * together, and holds the four characters, most significant first.
+ */
+static char vcd_nibble_chars[256][4];
+
+static void vcd_init_nibble_chars(void)
+{
+      unsigned idx, bit;
+
+      for (idx = 0 ; idx < 256 ; idx += 1) {
+	    for (bit = 0 ; bit < 4 ; bit += 1) {
+		  unsigned aval = (idx >> bit) & 1;
+		  unsigned bval = (idx >> (bit+4)) & 1;
+		  vcd_nibble_chars[idx][3-bit] = "01zx"[bval<<1 | aval];
+	    }
+      }
+}
+
+static char* vcd_format_bits(char*cp, const s_vpi_vecval*vec, unsigned wid)
+{
+      unsigned idx = wid;
+
+	/* The odd bits at the top, one at a time. */
+      while (idx % 4) {
+	    PLI_UINT32 aval, bval;
+	    idx -= 1;
+	    aval = ((PLI_UINT32)vec[idx/32].aval >> (idx%32)) & 1;
+	    bval = ((PLI_UINT32)vec[idx/32].bval >> (idx%32)) & 1;
+	    *cp++ = "01zx"[bval<<1 | aval];
+      }
+
+	/* Then the rest a nibble at a time. */
+      while (idx > 0) {
+	    PLI_UINT32 aval, bval;
+	    idx -= 4;
+	    aval = ((PLI_UINT32)vec[idx/32].aval >> (idx%32)) & 0xf;
+	    bval = ((PLI_UINT32)vec[idx/32].bval >> (idx%32)) & 0xf;
+	    memcpy(cp, vcd_nibble_chars[bval<<4 | aval], 4);
+	    cp += 4;
+      }
+
+      return cp;
+}
+
+/*
+ * Return how many of the leading bits of a vector value are redundant.
+ * A run of leading 0 bits is dropped if a 1 follows it, and any other
+ * leading run is cut to a single bit.
+ */
+static size_t truncate_bitvec(const char*str, size_t len)
+{
+      size_t idx;
+
+      if (str[0] == '1') return 0;
+
+      for (idx = 1 ; idx < len ; idx += 1) {
+	    if (str[idx] != str[0]) break;
+      }
+
+      if (idx == len) return len - 1;
+      if (str[0] == '0' && str[idx] == '1') return idx;
+      return idx - 1;
+}
+
+static void show_vector_value(const s_vpi_vecval*vec, unsigned wid,
+                              const char*ident)
+{
+      size_t ilen = strlen(ident);
+      size_t need = wid + ilen + 3;
+      char*buf, *cp;
+
+      if (need <= VCD_BUF_SIZE) buf = vcd_buf_reserve(need);
+      else buf = malloc(need);
+
+      cp = buf;
+      if (wid == 1) {
+	    *cp++ = "01zx"[(vec->bval & 1)<<1 | (vec->aval & 1)];
+      } else {
+	    char*bits = cp + 1;
+	    size_t skip;
+	    *cp++ = 'b';
+	    cp = vcd_format_bits(cp, vec, wid);
+	    skip = truncate_bitvec(bits, cp - bits);
+	    if (skip) {
+		  memmove(bits, bits + skip, cp - bits - skip);
+		  cp -= skip;
+	    }
+	    *cp++ = ' ';
+      }
+      memcpy(cp, ident, ilen);
+      cp += ilen;
+      *cp++ = '\n';
+
+      if (need <= VCD_BUF_SIZE) {
+	    vcd_buf_used += cp - buf;
+      } else {
+	    vcd_buf_put(buf, cp - buf);
+	    free(buf);
       }
 }
 
@@ -111,23 +402,31 @@ static void show_this_item(struct vcd_info*info)
       if (type == vpiRealVar) {
 	    value.format = vpiRealVal;
 	    vpi_get_value(info->item, &value);
-	    fprintf(dump_file, "r%.16g %s\n", value.value.real, info->ident);
+	    vcd_printf("r%.16g %s\n", value.value.real, info->ident);
       } else if (type == vpiNamedEvent) {
-	    fprintf(dump_file, "1%s\n", info->ident);
+	    vcd_printf("1%s\n", info->ident);
       } else if (type == vpiParameter && vpi_get(vpiConstType, info->item) == vpiRealConst) {
 
 	    value.format = vpiRealVal;
 	    vpi_get_value(info->item, &value);
-	    fprintf(dump_file, "r%.16g %s\n", value.value.real, info->ident);
-      } else if (vpi_get(vpiSize, info->item) == 1) {
+	    vcd_printf("r%.16g %s\n", value.value.real, info->ident);
+      } else if (type == vpiParameter) {
 	    value.format = vpiBinStrVal;
 	    vpi_get_value(info->item, &value);
-	    fprintf(dump_file, "%s%s\n", value.value.str, info->ident);
+	    if (vpi_get(vpiSize, info->item) == 1) {
+		  vcd_printf("%s%s\n", value.value.str, info->ident);
+	    } else {
+		  const char*str = value.value.str;
+		  str += truncate_bitvec(str, strlen(str));
+		  vcd_printf("b%s %s\n", str, info->ident);
+	    }
       } else {
-	    value.format = vpiBinStrVal;
+	      /* Everything else is a vector (or scalar) value. Get it
+	       * as aval/bval words and format those directly. */
+	    value.format = vpiVectorVal;
 	    vpi_get_value(info->item, &value);
-	    fprintf(dump_file, "b%s %s\n", truncate_bitvec(value.value.str),
-		    info->ident);
+	    show_vector_value(value.value.vector,
+	                      vpi_get(vpiSize, info->item), info->ident);
       }
 }
 
@@ -138,13 +437,13 @@ static void show_this_item_x(struct vcd_info*info)
 
       if (type == vpiRealVar) {
 	      /* Some tools dump nothing here...? */
-	    fprintf(dump_file, "rNaN %s\n", info->ident);
+	    vcd_printf("rNaN %s\n", info->ident);
       } else if (type == vpiNamedEvent) {
 	    /* Do nothing for named events. */
       } else if (vpi_get(vpiSize, info->item) == 1) {
-	    fprintf(dump_file, "x%s\n", info->ident);
+	    vcd_printf("x%s\n", info->ident);
       } else {
-	    fprintf(dump_file, "bx %s\n", info->ident);
+	    vcd_printf("bx %s\n", info->ident);
       }
 }
 
@@ -170,7 +469,7 @@ static PLI_INT32 variable_cb_2(p_cb_data cause)
       PLI_UINT64 now = timerec_to_time64(cause->time);
 
       if (now != vcd_cur_time) {
-	    fprintf(dump_file, "#%" PLI_UINT64_FMT "\n", now);
+	    vcd_put_time(now);
 	    vcd_cur_time = now;
       }
 
@@ -194,12 +493,13 @@ static PLI_INT32 variable_cb_1(p_cb_data cause)
       if (dump_header_pending()) return 0;
       if (info->scheduled) return 0;
 
-      if ((dump_limit > 0) && (ftell(dump_file) > dump_limit)) {
+      if ((dump_limit > 0) &&
+          (vcd_buf_written + (long)vcd_buf_used > dump_limit)) {
             dump_is_full = 1;
             vpi_printf("WARNING: Dump file limit (%ld bytes) "
                                "exceeded.\n", dump_limit);
-            fprintf(dump_file, "$comment Dump file limit (%ld bytes) "
-                               "exceeded. $end\n", dump_limit);
+            vcd_printf("$comment Dump file limit (%ld bytes) "
+                       "exceeded. $end\n", dump_limit);
             return 0;
       }
 
@@ -232,19 +532,19 @@ static PLI_INT32 dumpvars_cb(p_cb_data cause)
       dumpvars_time = timerec_to_time64(cause->time);
       vcd_cur_time = dumpvars_time;
 
-      fprintf(dump_file, "$enddefinitions $end\n");
+      vcd_printf("$enddefinitions $end\n");
 
       if (!dump_is_off) {
-	    fprintf(dump_file, "$comment Show the parameter values. $end\n");
-	    fprintf(dump_file, "$dumpall\n");
+	    vcd_printf("$comment Show the parameter values. $end\n");
+	    vcd_printf("$dumpall\n");
 	    ITERATE_VCD_INFO(vcd_const_list, vcd_info, next, show_this_item);
-	    fprintf(dump_file, "$end\n");
+	    vcd_printf("$end\n");
 
-	    fprintf(dump_file, "#%" PLI_UINT64_FMT "\n", dumpvars_time);
+	    vcd_printf("#%" PLI_UINT64_FMT "\n", dumpvars_time);
 
-	    fprintf(dump_file, "$dumpvars\n");
+	    vcd_printf("$dumpvars\n");
 	    ITERATE_VCD_INFO(vcd_list, vcd_info, next, show_this_item);
-	    fprintf(dump_file, "$end\n");
+	    vcd_printf("$end\n");
       }
 
       return 0;
@@ -261,9 +561,10 @@ static PLI_INT32 finish_cb(p_cb_data cause)
       dumpvars_time = timerec_to_time64(cause->time);
 
       if (!dump_is_off && !dump_is_full && dumpvars_time != vcd_cur_time) {
-	    fprintf(dump_file, "#%" PLI_UINT64_FMT "\n", dumpvars_time);
+	    vcd_printf("#%" PLI_UINT64_FMT "\n", dumpvars_time);
       }
 
+      vcd_buf_close();
       fclose(dump_file);
 
       for (cur = vcd_list ;  cur ;  cur = next) {
@@ -335,13 +636,13 @@ static PLI_INT32 sys_dumpoff_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
       now64 = timerec_to_time64(&now);
 
       if (now64 > vcd_cur_time) {
-	    fprintf(dump_file, "#%" PLI_UINT64_FMT "\n", now64);
+	    vcd_printf("#%" PLI_UINT64_FMT "\n", now64);
 	    vcd_cur_time = now64;
       }
 
-      fprintf(dump_file, "$dumpoff\n");
+      vcd_printf("$dumpoff\n");
       ITERATE_VCD_INFO(vcd_list, vcd_info, next, show_this_item_x);
-      fprintf(dump_file, "$end\n");
+      vcd_printf("$end\n");
 
       return 0;
 }
@@ -365,13 +666,13 @@ static PLI_INT32 sys_dumpon_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
       now64 = timerec_to_time64(&now);
 
       if (now64 > vcd_cur_time) {
-	    fprintf(dump_file, "#%" PLI_UINT64_FMT "\n", now64);
+	    vcd_printf("#%" PLI_UINT64_FMT "\n", now64);
 	    vcd_cur_time = now64;
       }
 
-      fprintf(dump_file, "$dumpon\n");
+      vcd_printf("$dumpon\n");
       ITERATE_VCD_INFO(vcd_list, vcd_info, next, show_this_item);
-      fprintf(dump_file, "$end\n");
+      vcd_printf("$end\n");
 
       return 0;
 }
@@ -392,13 +693,13 @@ static PLI_INT32 sys_dumpall_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
       now64 = timerec_to_time64(&now);
 
       if (now64 > vcd_cur_time) {
-	    fprintf(dump_file, "#%" PLI_UINT64_FMT "\n", now64);
+	    vcd_printf("#%" PLI_UINT64_FMT "\n", now64);
 	    vcd_cur_time = now64;
       }
 
-      fprintf(dump_file, "$dumpall\n");
+      vcd_printf("$dumpall\n");
       ITERATE_VCD_INFO(vcd_list, vcd_info, next, show_this_item);
-      fprintf(dump_file, "$end\n");
+      vcd_printf("$end\n");
 
       return 0;
 }
@@ -426,6 +727,8 @@ static void open_dumpfile(vpiHandle callh)
 	    vpi_printf("VCD info: dumpfile %s opened for output.\n",
 	               use_dump_path);
 
+	    vcd_buf_open();
+
 	    time(&walltime);
 
 	    assert(prec >= -15);
@@ -439,16 +742,16 @@ static void open_dumpfile(vpiHandle callh)
 	    }
 
 		if (!dump_no_date) {
-			fprintf(dump_file, "$date\n");
-			fprintf(dump_file, "\t%s",asctime(localtime(&walltime)));
-			fprintf(dump_file, "$end\n");
+			vcd_printf("$date\n");
+			vcd_printf("\t%s",asctime(localtime(&walltime)));
+			vcd_printf("$end\n");
 		}
-	    fprintf(dump_file, "$version\n");
-	    fprintf(dump_file, "\tIcarus Verilog\n");
-	    fprintf(dump_file, "$end\n");
-	    fprintf(dump_file, "$timescale\n");
-	    fprintf(dump_file, "\t%u%s\n", scale, units_names[udx]);
-	    fprintf(dump_file, "$end\n");
+	    vcd_printf("$version\n");
+	    vcd_printf("\tIcarus Verilog\n");
+	    vcd_printf("$end\n");
+	    vcd_printf("$timescale\n");
+	    vcd_printf("\t%u%s\n", scale, units_names[udx]);
+	    vcd_printf("$end\n");
       }
 }
 
@@ -461,7 +764,7 @@ static PLI_INT32 sys_dumpfile_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 static PLI_INT32 sys_dumpflush_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 {
       (void)name; /* Parameter is not used. */
-      if (dump_file) fflush(dump_file);
+      if (dump_file) vcd_buf_flush();
 
       return 0;
 }
@@ -636,7 +939,10 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 		    /* Add a callback for the signal. */
 		  info = malloc(sizeof(*info));
 
-		  info->time.type = vpiSimTime;
+		    /* The change callback does not need the time, since
+		       the values are written from a read-only sync
+		       callback, so save vvp filling it in. */
+		  info->time.type = vpiSuppressTime;
 		  info->item  = item;
 		  info->ident = ident;
 		  info->scheduled = 0;
@@ -661,17 +967,17 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 	    if (item_type == vpiNamedEvent) size = 1;
 	    else size = vpi_get(vpiSize, item);
 
-	    fprintf(dump_file, "$var %s %u %s %s%s",
-		    type, size, ident, prefix, name);
+	    vcd_printf("$var %s %u %s %s%s",
+		       type, size, ident, prefix, name);
 
 	      /* Add a range for vectored values. */
 	    if (size > 1 || vpi_get(vpiLeftRange, item) != 0) {
-		  fprintf(dump_file, " [%i:%i]",
-			  (int)vpi_get(vpiLeftRange, item),
-			  (int)vpi_get(vpiRightRange, item));
+		  vcd_printf(" [%i:%i]",
+			     (int)vpi_get(vpiLeftRange, item),
+			     (int)vpi_get(vpiRightRange, item));
 	    }
 
-	    fprintf(dump_file, " $end\n");
+	    vcd_printf(" $end\n");
 	    break;
 
 	  case vpiParameter:
@@ -699,8 +1005,8 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 	    info->cb = NULL;
 
 	    /* Generate the $var record. Now the parameter is declared. */
-	    fprintf(dump_file, "$var %s %u %s %s%s $end\n",
-		    type, size, ident, prefix, name);
+	    vcd_printf("$var %s %u %s %s%s $end\n",
+		       type, size, ident, prefix, name);
 	    break;
 
 	  case vpiModule:
@@ -724,7 +1030,7 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 		  }
 
 		  name = vpi_get_str(vpiName, item);
-		  fprintf(dump_file, "$scope %s %s $end\n", type, name);
+		  vcd_printf("$scope %s %s $end\n", type, name);
 
 		  for (i=0; dumpable_types[i]>0; i++) {
 			vpiHandle hand;
@@ -735,7 +1041,7 @@ static void scan_item(unsigned depth, vpiHandle item, int skip)
 		  }
 
 		    /* Sort any signals that we added above. */
-		  fprintf(dump_file, "$upscope $end\n");
+		  vcd_printf("$upscope $end\n");
 	    }
 	    break;
 
@@ -776,7 +1082,7 @@ static int draw_scope(vpiHandle item, vpiHandle callh)
             assert(0);
       }
 
-      fprintf(dump_file, "$scope %s %s $end\n", type, name);
+      vcd_printf("$scope %s %s $end\n", type, name);
 
       return depth;
 }
@@ -869,7 +1175,7 @@ static PLI_INT32 sys_dumpvars_calltf(ICARUS_VPI_CONST PLI_BYTE8*name)
 	      /* The scope list must be sorted after we scan an item.  */
 	    vcd_names_sort(&vcd_tab);
 
-	    while (dep--) fprintf(dump_file, "$upscope $end\n");
+	    while (dep--) vcd_printf("$upscope $end\n");
 
 	      /* Add this signal to the variable list so we can verify it
 	       * is not included twice. This must be done after it has
@@ -896,9 +1202,13 @@ void sys_vcd_register(void)
       for (idx = 0 ;  idx < vlog_info.argc ;  idx += 1) {
         if (strcmp(vlog_info.argv[idx],"-no-date") == 0) {
           dump_no_date = 1;
+        } else if (strcmp(vlog_info.argv[idx],"-vcd-parallel") == 0) {
+          dump_parallel = 1;
         }
       }
 
+      vcd_init_nibble_chars();
+
       /* All the compiletf routines are located in vcd_priv.c. */
 
       tf_data.type      = vpiSysTask;
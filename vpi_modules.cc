@@ -128,6 +128,10 @@ void        vpip_format_strength(char*, s_vpi_value*, unsigned) { }
 void        vpip_make_systf_system_defined(vpiHandle) { }
 void        vpip_mcd_rawwrite(PLI_UINT32, const char*, size_t) { }
 void        vpip_set_return_value(int) { }
+PLI_INT32   vpip_put_array_words(vpiHandle, PLI_INT32, PLI_UINT32, const s_vpi_vecval*) { return 0; }
+PLI_INT32   vpip_get_array_words(vpiHandle, PLI_INT32, PLI_UINT32, s_vpi_vecval*) { return 0; }
+PLI_INT32   vpip_put_values(PLI_UINT32, const vpiHandle*, const s_vpi_vecval*) { return 0; }
+PLI_INT32   vpip_get_values(PLI_UINT32, const vpiHandle*, s_vpi_vecval*) { return 0; }
 void        vpi_vcontrol(PLI_INT32, va_list) { }
 
 
@@ -230,6 +234,10 @@ vpip_routines_s vpi_routines = {
     .make_systf_system_defined  = vpip_make_systf_system_defined,
     .mcd_rawwrite               = vpip_mcd_rawwrite,
     .set_return_value           = vpip_set_return_value,
+    .put_array_words            = vpip_put_array_words,
+    .get_array_words            = vpip_get_array_words,
+    .put_values                 = vpip_put_values,
+    .get_values                 = vpip_get_values,
 };
 
 typedef PLI_UINT32 (*vpip_set_callback_t)(vpip_routines_s*, PLI_UINT32);
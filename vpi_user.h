@@ -408,6 +408,7 @@ typedef struct t_vpi_delay  {
 #  define _vpiDelaySelMaximum 3
 /* used in vvp/vpi_priv.h  0x1000003 */
 /* used in vvp/vpi_priv.h  0x1000004 */
+#define _vpiWordSize       0x1000005 /* width of the words of a memory */
 
 /* DELAY MODES */
 #define vpiNoDelay            1
@@ -664,6 +665,34 @@ extern void vpip_mcd_rawwrite(PLI_UINT32 mcd, const char*buf, size_t count);
 extern void vpip_count_drivers(vpiHandle ref, unsigned idx,
                                unsigned counts[4]);
 
+  /* Write or read 'count' consecutive words of a memory, starting at
+     the word with address 'addr' and going up in address. Each word
+     takes (width+31)/32 entries of the 'vals' array, where width is
+     the _vpiWordSize of the memory. A put is the same as a
+     vpi_put_value with vpiNoDelay to each word. These return the
+     number of words that were transferred. This is 0 if the memory
+     does not support this, and then the words must be accessed one at
+     a time through their handles. */
+extern PLI_INT32 vpip_put_array_words(vpiHandle mem, PLI_INT32 addr,
+                                      PLI_UINT32 count,
+                                      const s_vpi_vecval*vals);
+extern PLI_INT32 vpip_get_array_words(vpiHandle mem, PLI_INT32 addr,
+                                      PLI_UINT32 count, s_vpi_vecval*vals);
+
+  /* Read or write the values of 'count' objects in one call. The
+     value of handles[i] takes (size+31)/32 entries of the 'vals'
+     array, where size is the vpiSize of the object, and the values
+     are packed one after the other in handle order. The objects must
+     be nets, variables, part selects or memory words that have vector
+     values. A put is the same as a vpi_put_value with vpiNoDelay to
+     each object. These return the number of objects that were
+     transferred, which is less than 'count' if an object does not
+     have a vector value. */
+extern PLI_INT32 vpip_put_values(PLI_UINT32 count, const vpiHandle*handles,
+                                 const s_vpi_vecval*vals);
+extern PLI_INT32 vpip_get_values(PLI_UINT32 count, const vpiHandle*handles,
+                                 s_vpi_vecval*vals);
+
 /*
  * Stopgap fix for br916. We need to reject any attempt to pass a thread
  * variable to $strobe or $monitor. To do this, we use some private VPI
@@ -693,7 +722,7 @@ extern void vpip_count_drivers(vpiHandle ref, unsigned idx,
  */
 
 // Increment the version number any time vpip_routines_s is changed.
-static const PLI_UINT32 vpip_routines_version = 1;
+static const PLI_UINT32 vpip_routines_version = 3;
 
 typedef struct {
     vpiHandle   (*register_cb)(p_cb_data);
@@ -736,6 +765,10 @@ typedef struct {
     void        (*make_systf_system_defined)(vpiHandle);
     void        (*mcd_rawwrite)(PLI_UINT32, const char*, size_t);
     void        (*set_return_value)(int);
+    PLI_INT32   (*put_array_words)(vpiHandle, PLI_INT32, PLI_UINT32, const s_vpi_vecval*);
+    PLI_INT32   (*get_array_words)(vpiHandle, PLI_INT32, PLI_UINT32, s_vpi_vecval*);
+    PLI_INT32   (*put_values)(PLI_UINT32, const vpiHandle*, const s_vpi_vecval*);
+    PLI_INT32   (*get_values)(PLI_UINT32, const vpiHandle*, s_vpi_vecval*);
 } vpip_routines_s;
 
 extern DLLEXPORT PLI_UINT32 vpip_set_callback(vpip_routines_s*routines, PLI_UINT32 version);
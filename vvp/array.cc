@@ -44,6 +44,14 @@ unsigned long count_var_arrays = 0;
 unsigned long count_var_array_words = 0;
 unsigned long count_real_arrays = 0;
 unsigned long count_real_array_words = 0;
+unsigned long count_sparse_arrays = 0;
+
+static unsigned long sparse_array_words = 1UL << 20;
+
+void array_set_sparse_words(unsigned long words)
+{
+      sparse_array_words = words;
+}
 
 static symbol_map_s<struct __vpiArray>* array_table =0;
 
@@ -270,6 +278,9 @@ int __vpiArray::vpi_get(int code)
 	  case vpiSize:
 	    return get_size();
 
+	  case _vpiWordSize:
+	    return get_word_size();
+
 	  case vpiAutomatic:
 	    return scope->is_automatic()? 1 : 0;
 
@@ -889,6 +900,47 @@ void __vpiArray::attach_word(unsigned addr, vpiHandle word)
       }
 }
 
+/*
+ * Bulk access to the words of a logic memory. The $readmem and
+ * $writemem tasks use these to move a whole file of words without
+ * making a VPI handle for each word. Net arrays and arrays of other
+ * types are not supported, so the caller falls back to the handles.
+ */
+extern "C" PLI_INT32 vpip_put_array_words(vpiHandle ref, PLI_INT32 addr,
+					  PLI_UINT32 count,
+					  const s_vpi_vecval*vals)
+{
+      struct __vpiArray*arr = dynamic_cast<__vpiArray*>(ref);
+      if (arr == 0 || arr->vals4 == 0)
+	    return 0;
+
+      long index = (long)addr - arr->first_addr.get_value();
+      if (index < 0 || index + count > arr->get_size())
+	    return 0;
+
+      arr->vals4->set_vecvals(index, count, vals);
+      for (unsigned idx = 0 ; idx < count ; idx += 1)
+	    arr->word_change(index + idx);
+
+      return count;
+}
+
+extern "C" PLI_INT32 vpip_get_array_words(vpiHandle ref, PLI_INT32 addr,
+					  PLI_UINT32 count,
+					  s_vpi_vecval*vals)
+{
+      struct __vpiArray*arr = dynamic_cast<__vpiArray*>(ref);
+      if (arr == 0 || arr->vals4 == 0)
+	    return 0;
+
+      long index = (long)addr - arr->first_addr.get_value();
+      if (index < 0 || index + count > arr->get_size())
+	    return 0;
+
+      arr->vals4->get_vecvals(index, count, vals);
+      return count;
+}
+
 void compile_var_array(char*label, char*name, int last, int first,
 		   int msb, int lsb, char signed_flag)
 {
@@ -902,6 +954,10 @@ void compile_var_array(char*label, char*name, int last, int first,
       if (vpip_peek_current_scope()->is_automatic()) {
             arr->vals4 = new vvp_vector4array_aa(arr->vals_width,
 						 arr->get_size());
+      } else if (sparse_array_words && arr->get_size() > sparse_array_words) {
+            arr->vals4 = new vvp_vector4array_sp(arr->vals_width,
+						 arr->get_size());
+            count_sparse_arrays += 1;
       } else {
             arr->vals4 = new vvp_vector4array_sa(arr->vals_width,
 						 arr->get_size());
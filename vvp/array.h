@@ -31,6 +31,12 @@ class value_callback;
  */
 extern vvp_array_t array_find(const char*label);
 
+/*
+ * Static logic arrays with more than this many words use the sparse
+ * (paged) word storage. Zero disables the sparse storage.
+ */
+extern void array_set_sparse_words(unsigned long words);
+
 /* VPI hooks */
 extern value_callback* vpip_array_word_change(p_cb_data data);
 extern value_callback* vpip_array_change(p_cb_data data);
@@ -50,8 +50,10 @@ void codespace_init(void)
       current_chunk = first_chunk;
 
       current_chunk[0].opcode = &of_ZOMBIE;
+      current_chunk[0].dispatch = 0;
 
       current_chunk[code_chunk_size-1].opcode = &of_CHUNK_LINK;
+      current_chunk[code_chunk_size-1].dispatch = 0;
       current_chunk[code_chunk_size-1].cptr = 0;
 
       current_within_chunk = 1;
@@ -69,6 +71,7 @@ vvp_code_t codespace_next(void)
 
 	      /* Put a link opcode on the end of the chunk. */
 	    current_chunk[code_chunk_size-1].opcode = &of_CHUNK_LINK;
+	    current_chunk[code_chunk_size-1].dispatch = 0;
 	    current_chunk[code_chunk_size-1].cptr   = 0;
 
 	    current_within_chunk = 0;
@@ -96,6 +99,18 @@ vvp_code_t codespace_null(void)
       return first_chunk + 0;
 }
 
+void codespace_each_chunk(void (*fun)(vvp_code_t base, unsigned count))
+{
+      for (vvp_code_t cur = first_chunk ; cur ; ) {
+	    if (cur == current_chunk) {
+		  fun(cur, current_within_chunk);
+		  break;
+	    }
+	    fun(cur, code_chunk_size-1);
+	    cur = cur[code_chunk_size-1].cptr;
+      }
+}
+
 #ifdef CHECK_WITH_VALGRIND
 void codespace_delete(void)
 {
@@ -275,11 +275,25 @@ extern bool of_REAP_UFUNC(vthread_t thr, vvp_code_t code);
 
 extern bool of_CHUNK_LINK(vthread_t thr, vvp_code_t code);
 
+/*
+ * These are fused instructions. They are not in the opcode table, but
+ * are substituted by compile_cleanup for common sequences of the
+ * instructions above. See compile_fuse_opcodes in compile.cc.
+ */
+extern bool of_FUSE_LOAD_CMPIE(vthread_t thr, vvp_code_t code);
+extern bool of_FUSE_LOAD_CMPINE(vthread_t thr, vvp_code_t code);
+extern bool of_FUSE_LOAD_ADDI_STORE(vthread_t thr, vvp_code_t code);
+extern bool of_FUSE_LOAD_SUBI_STORE(vthread_t thr, vvp_code_t code);
+
 /*
  * This is the format of a machine code instruction.
  */
 struct vvp_code_s {
       vvp_code_fun opcode;
+	/* The threaded dispatch loop in vthread.cc keeps here the
+	   address of the handler that executes this opcode. It is
+	   nil until the instruction is first executed. */
+      const void*dispatch;
 
       union {
 	    unsigned long number;
@@ -317,4 +331,12 @@ extern vvp_code_t codespace_allocate(void);
 extern vvp_code_t codespace_next(void);
 extern vvp_code_t codespace_null(void);
 
+/*
+ * Call the fun for each chunk of code space, passing the address of
+ * the first instruction in the chunk and the number of instructions
+ * allocated in it. The count does not include the CHUNK_LINK
+ * instruction at the end of each chunk.
+ */
+extern void codespace_each_chunk(void (*fun)(vvp_code_t base, unsigned count));
+
 #endif /* IVL_codes_H */
@@ -27,13 +27,16 @@
 # include  "udp.h"
 # include  "symbols.h"
 # include  "codes.h"
+# include  "cone.h"
 # include  "schedule.h"
 # include  "vpi_priv.h"
 # include  "parse_misc.h"
 # include  "statistics.h"
 # include  "schedule.h"
+# include  "vvp_net_sig.h"
 # include  <iostream>
 # include  <list>
+# include  <set>
 # include  <cstdlib>
 # include  <cstring>
 # include  <cassert>
@@ -337,6 +340,13 @@ static int opcode_compare(const void*k, const void*r)
  */
 static symbol_table_t sym_codespace = 0;
 
+/*
+ * These are all the code addresses that have labels. Only a labeled
+ * instruction can be the target of a jump, so this is used to make
+ * sure nothing jumps into the middle of a fused sequence.
+ */
+static std::set<vvp_code_t> code_labels;
+
 /*
  * Keep a symbol table of functors mentioned in the source. This table
  * is used to resolve references as they come.
@@ -766,6 +776,97 @@ void compile_compiletf(struct __vpiSysTaskCall*obj)
  * the final stuff. Clean up deferred linking here.
  */
 
+unsigned long count_fused_cmp = 0;
+unsigned long count_fused_addi = 0;
+
+/*
+ * Return the width of the signal that the net carries, or 0 if the
+ * net is not a vector signal.
+ */
+static unsigned fuse_signal_width(vvp_net_t*net)
+{
+      if (net == 0)
+	    return 0;
+      vvp_signal_value*sig = dynamic_cast<vvp_signal_value*> (net->fil);
+      if (sig == 0)
+	    return 0;
+      return sig->value_size();
+}
+
+/*
+ * Look for these common sequences in the instructions of a code
+ * chunk, and replace the first instruction of each with a fused
+ * instruction that does the work of the whole sequence without
+ * pushing the intermediate values onto the vec4 stack:
+ *
+ *    %load/vec4 <net>; %cmpi/e <vala>, <valb>, <wid>
+ *    %load/vec4 <net>; %cmpi/ne <vala>, <valb>, <wid>
+ *    %load/vec4 <net>; %pushi/vec4 <vala>, <valb>, <wid>; %cmp/e
+ *    %load/vec4 <net>; %pushi/vec4 <vala>, <valb>, <wid>; %cmp/ne
+ *    %load/vec4 <net>; %addi <vala>, <valb>, <wid>; %store/vec4 <net>, 0, <wid>
+ *    %load/vec4 <net>; %subi <vala>, <valb>, <wid>; %store/vec4 <net>, 0, <wid>
+ *
+ * The fused instruction keeps its <net> operand, and records in
+ * bit_idx[0] the number of instructions in the sequence. The rest of
+ * the sequence is left in place, because the fused instruction gets
+ * its operands from there, but is skipped over. This means that no
+ * instruction after the first may have a label.
+ */
+static void compile_fuse_chunk(vvp_code_t base, unsigned count)
+{
+      for (unsigned idx = 0 ; idx+1 < count ; idx += 1) {
+	    vvp_code_t cp = base + idx;
+	    if (cp->opcode != &of_LOAD_VEC4)
+		  continue;
+
+	    unsigned wid = fuse_signal_width(cp->net);
+	    if (wid == 0)
+		  continue;
+
+	    vvp_code_t op = cp + 1;
+	    if (code_labels.count(op) || op->number != wid)
+		  continue;
+
+	    vvp_code_t last = idx+2 < count? cp + 2 : 0;
+	    if (last && code_labels.count(last))
+		  last = 0;
+
+	    if (op->opcode == &of_CMPIE || op->opcode == &of_CMPINE) {
+		  cp->opcode = op->opcode == &of_CMPIE
+			? &of_FUSE_LOAD_CMPIE : &of_FUSE_LOAD_CMPINE;
+		  cp->bit_idx[0] = 2;
+		  count_fused_cmp += 1;
+
+	    } else if (op->opcode == &of_PUSHI_VEC4 && last
+		       && (last->opcode == &of_CMPE || last->opcode == &of_CMPNE)) {
+		  cp->opcode = last->opcode == &of_CMPE
+			? &of_FUSE_LOAD_CMPIE : &of_FUSE_LOAD_CMPINE;
+		  cp->bit_idx[0] = 3;
+		  count_fused_cmp += 1;
+
+	    } else if ((op->opcode == &of_ADDI || op->opcode == &of_SUBI)
+		       && last && last->opcode == &of_STORE_VEC4
+		       && last->net == cp->net
+		       && last->bit_idx[0] == 0 && last->bit_idx[1] == wid) {
+		  cp->opcode = op->opcode == &of_ADDI
+			? &of_FUSE_LOAD_ADDI_STORE : &of_FUSE_LOAD_SUBI_STORE;
+		  cp->bit_idx[0] = 3;
+		  count_fused_addi += 1;
+
+	    } else {
+		  continue;
+	    }
+
+	    idx += cp->bit_idx[0] - 1;
+      }
+}
+
+static void compile_fuse_opcodes(void)
+{
+      codespace_each_chunk(&compile_fuse_chunk);
+      code_labels.clear();
+}
+
 void compile_cleanup(void)
 {
       int lnerrs = -1;
@@ -802,6 +903,11 @@ void compile_cleanup(void)
 
       compile_errors += nerrs;
 
+	/* With all the code operands resolved, look for instruction
+	   sequences that can be fused. */
+      if (compile_errors == 0)
+	    compile_fuse_opcodes();
+
       if (verbose_flag) {
 	    fprintf(stderr, " ... Removing symbol tables\n");
 	    fflush(stderr);
@@ -826,6 +932,11 @@ void compile_cleanup(void)
       compile_island_cleanup();
       compile_array_cleanup();
 
+	/* With the net graph complete, gather the zero delay logic
+	   into combinational cones. */
+      if (compile_errors == 0)
+	    compile_cones();
+
       if (verbose_flag) {
 	    fprintf(stderr, " ... Compiletf functions\n");
 	    fflush(stderr);
@@ -1920,6 +2031,7 @@ void compile_codelabel(char*label)
 
       val.ptr = ptr;
       sym_set_value(sym_codespace, label, val);
+      code_labels.insert(ptr);
 
       free(label);
 }
@@ -90,6 +90,13 @@ extern void compile_load_vpi_module(char*name);
 
 extern void compile_vpi_time_precision(long pre);
 
+/*
+ * The :ivl_two_state header says that the design was compiled in
+ * two-state mode, so X and Z values stored into the 2-state
+ * variables and nets must be changed to 0.
+ */
+extern void compile_two_state(void);
+
 /*
  * This function is called by the parser to compile a functor
  * statement. The strings passed in are allocated by the lexor, but
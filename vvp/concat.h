@@ -44,6 +44,9 @@ class vvp_fun_concat  : public vvp_net_fun_t, protected vvp_gen_event_s  {
 
       void recv_vec4_pv(vvp_net_ptr_t port, const vvp_vector4_t&bit,
 			unsigned base, unsigned vwid, vvp_context_t) final;
+
+      vvp_gen_event_s* cone_event() final { return this; }
+
     private:
       void run_run() final;
 
@@ -68,6 +71,8 @@ class vvp_fun_concat8  : public vvp_net_fun_t, protected vvp_gen_event_s {
       void recv_vec8_pv(vvp_net_ptr_t p, const vvp_vector8_t&bit,
 			unsigned base, unsigned vwid) final;
 
+      vvp_gen_event_s* cone_event() final { return this; }
+
     private:
       void run_run() final;
 
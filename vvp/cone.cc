@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2026 Stephen Williams (steve@icarus.com)
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "config.h"
+# include  "cone.h"
+# include  "vvp_net.h"
+# include  "arith.h"
+# include  "concat.h"
+# include  "logic.h"
+# include  "part.h"
+# include  "statistics.h"
+# include  <unordered_map>
+# include  <climits>
+# include  <cassert>
+
+using namespace std;
+
+unsigned long count_cones = 0;
+unsigned long count_cone_functors = 0;
+
+static bool cones_enabled = true;
+
+void cones_set_enabled(bool flag)
+{
+      cones_enabled = flag;
+}
+
+vvp_cone_s::vvp_cone_s(const vector<vvp_gen_event_t>&members)
+: members_(members), dirty_((members.size()+63) / 64, 0)
+{
+      dirty_lo_ = dirty_.size();
+      dirty_hi_ = 0;
+      cursor_ = 0;
+      running_ = false;
+      scheduled_ = false;
+
+      for (unsigned idx = 0 ; idx < members_.size() ; idx += 1) {
+	    assert(members_[idx]->cone == 0);
+	    members_[idx]->cone = this;
+	    members_[idx]->cone_idx = idx;
+      }
+}
+
+vvp_cone_s::~vvp_cone_s()
+{
+}
+
+static inline unsigned cone_lowest_bit_(uint64_t word)
+{
+#if defined(__GNUC__)
+      return __builtin_ctzll(word);
+#else
+      unsigned idx = 0;
+      while ((word & 1) == 0) {
+	    word >>= 1;
+	    idx += 1;
+      }
+      return idx;
+#endif
+}
+
+void vvp_cone_s::run_run()
+{
+      scheduled_ = false;
+      running_ = true;
+
+      size_t wdx = dirty_lo_;
+      dirty_lo_ = dirty_.size();
+
+	// Evaluate the marked members in order. A member may mark
+	// members later in the order, so the upper limit may move.
+      for ( ; wdx <= dirty_hi_ && wdx < dirty_.size() ; wdx += 1) {
+	    while (uint64_t bits = dirty_[wdx]) {
+		  unsigned bit = cone_lowest_bit_(bits);
+		  dirty_[wdx] = bits & (bits - 1);
+		  cursor_ = wdx*64 + bit;
+		  members_[cursor_]->run_run();
+	    }
+      }
+
+      running_ = false;
+      if (! scheduled_)
+	    dirty_hi_ = 0;
+}
+
+/*
+ * The nodes of the graph that compile_cones() works on. Members are
+ * the functors that schedule their own event. The other nodes are
+ * functors that pass their result on as soon as an input arrives;
+ * they are not part of a cone, but the members they connect must
+ * still be ordered.
+ */
+struct cone_node_s {
+      vvp_net_t*net;
+      vvp_gen_event_t event;
+      vector<unsigned> out;
+	// For finding loops and sorting.
+      unsigned index, low, in_count;
+      bool on_stack, in_loop;
+};
+
+static bool cone_passes_through(vvp_net_fun_t*fun)
+{
+      if (dynamic_cast<vvp_arith_*>(fun)) return true;
+      if (dynamic_cast<vvp_fun_bufz*>(fun)) return true;
+      if (dynamic_cast<vvp_fun_drive*>(fun)) return true;
+      if (dynamic_cast<vvp_fun_part_pv*>(fun)) return true;
+      if (dynamic_cast<vvp_fun_repeat*>(fun)) return true;
+      if (dynamic_cast<vvp_fun_extend_signed*>(fun)) return true;
+      return false;
+}
+
+static unsigned cone_find_(vector<unsigned>&parent, unsigned idx)
+{
+      while (parent[idx] != idx) {
+	    parent[idx] = parent[parent[idx]];
+	    idx = parent[idx];
+      }
+      return idx;
+}
+
+/*
+ * Mark the nodes that are in loops. This is Tarjan's strongly
+ * connected components algorithm, without recursion so that long
+ * chains of logic do not overflow the stack. The nodes of a component
+ * with more than one node, or with a node that drives itself, are in
+ * a loop.
+ */
+static void cone_find_loops_(vector<cone_node_s>&nodes)
+{
+      const unsigned NONE = UINT_MAX;
+      unsigned next_index = 0;
+      vector<unsigned> stack;
+      vector<pair<unsigned,unsigned> > work;
+
+      for (unsigned idx = 0 ; idx < nodes.size() ; idx += 1)
+	    nodes[idx].index = NONE;
+
+      for (unsigned root = 0 ; root < nodes.size() ; root += 1) {
+	    if (nodes[root].index != NONE)
+		  continue;
+
+	    work.push_back(make_pair(root, 0U));
+	    while (! work.empty()) {
+		  unsigned cur = work.back().first;
+		  unsigned edge = work.back().second;
+		  cone_node_s&node = nodes[cur];
+
+		  if (edge == 0) {
+			node.index = next_index;
+			node.low = next_index;
+			next_index += 1;
+			stack.push_back(cur);
+			node.on_stack = true;
+		  }
+
+		  if (edge < node.out.size()) {
+			work.back().second = edge + 1;
+			unsigned tgt = node.out[edge];
+			if (nodes[tgt].index == NONE) {
+			      work.push_back(make_pair(tgt, 0U));
+			} else if (nodes[tgt].on_stack) {
+			      if (nodes[tgt].index < node.low)
+				    node.low = nodes[tgt].index;
+			}
+			continue;
+		  }
+
+		    // All the outputs are done. If this is the root of
+		    // a component, pop the component.
+		  if (node.low == node.index) {
+			bool loop = stack.back() != cur;
+			for (unsigned jdx = 0 ; jdx < node.out.size() ; jdx += 1)
+			      if (node.out[jdx] == cur) loop = true;
+			unsigned tmp;
+			do {
+			      tmp = stack.back();
+			      stack.pop_back();
+			      nodes[tmp].on_stack = false;
+			      nodes[tmp].in_loop = loop;
+			} while (tmp != cur);
+		  }
+
+		  work.pop_back();
+		  if (! work.empty()) {
+			cone_node_s&up = nodes[work.back().first];
+			if (node.low < up.low)
+			      up.low = node.low;
+		  }
+	    }
+      }
+}
+
+void compile_cones(void)
+{
+      if (! cones_enabled)
+	    return;
+
+      vector<vvp_net_t*> nets;
+      vvp_net_list_all(nets);
+
+      vector<cone_node_s> nodes;
+      unordered_map<vvp_net_t*,unsigned> node_map;
+      for (size_t idx = 0 ; idx < nets.size() ; idx += 1) {
+	    vvp_net_fun_t*fun = nets[idx]->fun;
+	    if (fun == 0)
+		  continue;
+
+	    vvp_gen_event_t event = fun->cone_event();
+	    if (event == 0 && !cone_passes_through(fun))
+		  continue;
+
+	    cone_node_s node;
+	    node.net = nets[idx];
+	    node.event = event;
+	    node.index = 0;
+	    node.low = 0;
+	    node.in_count = 0;
+	    node.on_stack = false;
+	    node.in_loop = false;
+	    node_map[nets[idx]] = nodes.size();
+	    nodes.push_back(node);
+      }
+      nets.clear();
+
+      if (nodes.size() < 2)
+	    return;
+
+	// Collect the connections between the nodes.
+      for (unsigned idx = 0 ; idx < nodes.size() ; idx += 1) {
+	    for (vvp_net_ptr_t cur = nodes[idx].net->out_ ; cur.ptr() != 0
+		       ; cur = cur.ptr()->port[cur.port()]) {
+		  unordered_map<vvp_net_t*,unsigned>::const_iterator tgt
+			= node_map.find(cur.ptr());
+		  if (tgt != node_map.end())
+			nodes[idx].out.push_back(tgt->second);
+	    }
+      }
+      node_map.clear();
+
+	// Functors in loops are left to schedule themselves, so that
+	// the loop settles as it always has.
+      cone_find_loops_(nodes);
+
+	// Sort the rest of the nodes so that every node comes after
+	// the nodes that drive it, and gather the connected nodes.
+      vector<unsigned> parent (nodes.size());
+      for (unsigned idx = 0 ; idx < nodes.size() ; idx += 1) {
+	    parent[idx] = idx;
+	    if (nodes[idx].in_loop)
+		  continue;
+	    for (unsigned jdx = 0 ; jdx < nodes[idx].out.size() ; jdx += 1) {
+		  unsigned tgt = nodes[idx].out[jdx];
+		  if (nodes[tgt].in_loop)
+			continue;
+		  nodes[tgt].in_count += 1;
+	    }
+      }
+
+      vector<unsigned> order;
+      for (unsigned idx = 0 ; idx < nodes.size() ; idx += 1) {
+	    if (!nodes[idx].in_loop && nodes[idx].in_count == 0)
+		  order.push_back(idx);
+      }
+      for (size_t pos = 0 ; pos < order.size() ; pos += 1) {
+	    cone_node_s&node = nodes[order[pos]];
+	    for (unsigned jdx = 0 ; jdx < node.out.size() ; jdx += 1) {
+		  unsigned tgt = node.out[jdx];
+		  if (nodes[tgt].in_loop)
+			continue;
+		  unsigned a = cone_find_(parent, order[pos]);
+		  unsigned b = cone_find_(parent, tgt);
+		  if (a != b) parent[b] = a;
+		  nodes[tgt].in_count -= 1;
+		  if (nodes[tgt].in_count == 0)
+			order.push_back(tgt);
+	    }
+      }
+
+	// Make a cone of each group that has more than one member.
+      vector<vector<vvp_gen_event_t> > groups (nodes.size());
+      for (size_t pos = 0 ; pos < order.size() ; pos += 1) {
+	    const cone_node_s&node = nodes[order[pos]];
+	    if (node.event == 0)
+		  continue;
+	    groups[cone_find_(parent, order[pos])].push_back(node.event);
+      }
+      nodes.clear();
+
+      for (unsigned idx = 0 ; idx < groups.size() ; idx += 1) {
+	    if (groups[idx].size() < 2)
+		  continue;
+	    new vvp_cone_s(groups[idx]);
+	    count_cones += 1;
+	    count_cone_functors += groups[idx].size();
+      }
+}
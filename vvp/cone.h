@@ -0,0 +1,101 @@
+#ifndef IVL_cone_H
+#define IVL_cone_H
+/*
+ * Copyright (c) 2026 Stephen Williams (steve@icarus.com)
+ *
+ *    This source code is free software; you can redistribute it
+ *    and/or modify it in source code form under the terms of the GNU
+ *    General Public License as published by the Free Software
+ *    Foundation; either version 2 of the License, or (at your option)
+ *    any later version.
+ *
+ *    This program is distributed in the hope that it will be useful,
+ *    but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *    MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *    GNU General Public License for more details.
+ *
+ *    You should have received a copy of the GNU General Public License
+ *    along with this program; if not, write to the Free Software
+ *    Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301, USA.
+ */
+
+# include  "schedule.h"
+# include  <vector>
+# include  <stdint.h>
+
+/*
+ * A combinational cone is a set of zero delay functors (gates, part
+ * selects, concatenations, ...) that drive one another without any
+ * loops. Normally each of these functors schedules an event of its
+ * own when an input changes, so a change that ripples through N
+ * levels of logic takes N trips through the event queue, and a gate
+ * with inputs from several levels may be evaluated more than once.
+ *
+ * The members of a cone are kept in topological order. When a member
+ * has an input change, schedule_functor() marks it in the cone, and
+ * the cone itself is scheduled once. When the cone runs, it evaluates
+ * the marked members in order, so that every member is evaluated at
+ * most once, after all the members that drive it. Each member still
+ * sends its result through its own net, so signals, callbacks and
+ * functors outside the cone see the results as before.
+ *
+ * The cones are found by compile_cones() when the design is loaded.
+ */
+class vvp_cone_s : public vvp_gen_event_s {
+
+    public:
+      explicit vvp_cone_s(const std::vector<vvp_gen_event_t>&members);
+      ~vvp_cone_s();
+
+      inline void mark(unsigned idx);
+
+    private:
+      void run_run();
+
+    private:
+      std::vector<vvp_gen_event_t> members_;
+	// One bit per member, set if the member needs to be evaluated,
+	// and the range of words that may have bits set.
+      std::vector<uint64_t> dirty_;
+      size_t dirty_lo_, dirty_hi_;
+	// The member being evaluated, while the cone is running.
+      unsigned cursor_;
+      bool running_;
+      bool scheduled_;
+};
+
+inline void vvp_cone_s::mark(unsigned idx)
+{
+      size_t wdx = idx / 64;
+      dirty_[wdx] |= (uint64_t)1 << (idx % 64);
+
+	// A member after the cursor is evaluated by the running pass.
+      if (running_ && idx > cursor_) {
+	    if (wdx > dirty_hi_) dirty_hi_ = wdx;
+	    return;
+      }
+
+	// Otherwise, this needs another pass. This only happens if the
+	// cone drives itself through functors that are not members.
+      if (wdx < dirty_lo_) dirty_lo_ = wdx;
+      if (wdx > dirty_hi_) dirty_hi_ = wdx;
+      if (! scheduled_) {
+	    scheduled_ = true;
+	    schedule_functor(this);
+      }
+}
+
+/*
+ * Gather the zero delay functors of the design into cones. This is
+ * called once the design is linked. It does nothing if cones are
+ * disabled.
+ */
+extern void compile_cones(void);
+
+/*
+ * Enable (the default) or disable the combinational cones. This must
+ * be called before the design is compiled.
+ */
+extern void cones_set_enabled(bool flag);
+
+#endif /* IVL_cone_H */
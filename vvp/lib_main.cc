@@ -20,6 +20,8 @@ const char COPYRIGHT[] =
 # include  "version_base.h"
 # include  "config.h"
 # include  "compile.h"
+# include  "array.h"
+# include  "cone.h"
 # include  "schedule.h"
 # include  "vpi_priv.h"
 # include  "statistics.h"
@@ -114,7 +116,7 @@ static void my_getrusage(struct rusage *a)
 #     endif
 }
 
-static void print_rusage(struct rusage *a, struct rusage *b)
+static double print_rusage(struct rusage *a, struct rusage *b)
 {
       double delta = a->ru_utime.tv_sec
 	    +        a->ru_utime.tv_usec/1E6
@@ -133,6 +135,8 @@ static void print_rusage(struct rusage *a, struct rusage *b)
 	      a->ru_maxrss/1024.0,
 	      (a->ru_idrss+a->ru_isrss)/1024.0,
 	      a->ru_ixrss/1024.0 );
+
+      return delta;
 }
 
 #else // ! defined(HAVE_SYS_RESOURCE_H)
@@ -140,10 +144,14 @@ static void print_rusage(struct rusage *a, struct rusage *b)
 // Provide dummies
 struct rusage { int x; };
 inline static void my_getrusage(struct rusage *) { }
-inline static void print_rusage(struct rusage *, struct rusage *){};
+inline static double print_rusage(struct rusage *, struct rusage *){ return 0.0; }
 
 #endif // ! defined(HAVE_SYS_RESOURCE_H)
 
+  // The resource usage when vvp_init starts, so that the compile time
+  // includes loading the VPI modules.
+static struct rusage init_cycle;
+
 static bool have_ivl_version = false;
 /*
  * Verify that the input file has a compatible version.
@@ -274,7 +282,6 @@ static void report_used(void)
 
 void vvp_init(const char *logfile_name, int argc, char*argv[])
 {
-      struct rusage cycle;
       FILE *logfile = 0x0;
       extern void vpi_set_vlog_info(int, char**);
 
@@ -324,7 +331,7 @@ void vvp_init(const char *logfile_name, int argc, char*argv[])
       vpip_mcd_init(logfile);
 
       if (verbose_flag) {
-	    my_getrusage(&cycle);
+	    my_getrusage(&init_cycle);
 	    vpi_mcd_printf(1, "Compiling VVP ...\n");
       }
 
@@ -333,12 +340,31 @@ void vvp_init(const char *logfile_name, int argc, char*argv[])
 	/* Make the extended arguments available to the simulation. */
       vpi_set_vlog_info(argc, argv);
 
+	/* A few of the extended arguments control the simulation
+	   engine itself. The rest are left for the VPI modules. */
+      for (int idx = 0 ; idx < argc ; idx += 1) {
+	    if (strcmp(argv[idx], "-sched-list") == 0)
+		  schedule_select_queue(SCHED_LIST);
+	    else if (strcmp(argv[idx], "-sched-wheel") == 0)
+		  schedule_select_queue(SCHED_WHEEL);
+	    else if (strcmp(argv[idx], "-dispatch-call") == 0)
+		  vthread_set_threaded_dispatch(false);
+	    else if (strcmp(argv[idx], "-dispatch-threaded") == 0)
+		  vthread_set_threaded_dispatch(true);
+	    else if (strncmp(argv[idx], "-sparse-array=", 14) == 0)
+		  array_set_sparse_words(strtoul(argv[idx]+14, 0, 0));
+	    else if (strcmp(argv[idx], "-logic-levelized") == 0)
+		  cones_set_enabled(true);
+	    else if (strcmp(argv[idx], "-logic-functor") == 0)
+		  cones_set_enabled(false);
+      }
+
       compile_init();
 }
 
 int vvp_run(const char *design_path)
 {
-      struct rusage cycles[3];
+      struct rusage cycles[4];
       int ret_cd;
 
       if (vvp_used++ != 1) {
@@ -350,11 +376,18 @@ int vvp_run(const char *design_path)
       }
       ++vvp_used;
 
+      cycles[0] = init_cycle;
       ret_cd = compile_design(design_path);
       destroy_lexor();
       print_vpi_call_errors();
       if (ret_cd) return ret_cd;
 
+      if (verbose_flag) {
+	    my_getrusage(cycles+1);
+	    vpi_mcd_printf(1, "Parsed VVP file\n");
+	    print_rusage(cycles+1, cycles+0);
+      }
+
       if (!have_ivl_version) {
 	    if (verbose_flag) vpi_mcd_printf(1, "... ");
 	    vpi_mcd_printf(1, "Warning: vvp input file may not be correct "
@@ -385,23 +418,38 @@ int vvp_run(const char *design_path)
 			   count_filters, vvp_net_fil_t::heap_total());
 	    vpi_mcd_printf(1, " ... %8lu opcodes (%zu bytes)\n",
 	                   count_opcodes, size_opcodes);
+	    vpi_mcd_printf(1, "           %8lu fused load/compare\n",
+			   count_fused_cmp);
+	    vpi_mcd_printf(1, "           %8lu fused load/add/store\n",
+			   count_fused_addi);
 	    vpi_mcd_printf(1, " ... %8lu nets\n",     count_vpi_nets);
 	    vpi_mcd_printf(1, " ... %8lu vvp_nets (%zu bytes)\n",
 			   count_vvp_nets, size_vvp_nets);
+	    unsigned long count_parts, count_part_largest;
+	    count_net_partitions(count_parts, count_part_largest);
+	    vpi_mcd_printf(1, "           %8lu independent regions "
+			   "(largest %lu vvp_nets)\n",
+			   count_parts, count_part_largest);
+	    vpi_mcd_printf(1, "           %8lu combinational cones "
+			   "(%lu functors)\n",
+			   count_cones, count_cone_functors);
 	    vpi_mcd_printf(1, " ... %8lu arrays (%lu words)\n",
 			   count_net_arrays, count_net_array_words);
 	    vpi_mcd_printf(1, " ... %8lu memories\n",
 			   count_var_arrays+count_real_arrays);
 	    vpi_mcd_printf(1, "           %8lu logic (%lu words)\n",
 			   count_var_arrays, count_var_array_words);
+	    if (count_sparse_arrays)
+		  vpi_mcd_printf(1, "           %8lu of them sparse\n",
+				 count_sparse_arrays);
 	    vpi_mcd_printf(1, "           %8lu real (%lu words)\n",
 			   count_real_arrays, count_real_array_words);
 	    vpi_mcd_printf(1, " ... %8lu scopes\n",   count_vpi_scopes);
       }
 
       if (verbose_flag) {
-	    my_getrusage(cycles+1);
-	    print_rusage(cycles+1, cycles+0);
+	    my_getrusage(cycles+2);
+	    print_rusage(cycles+2, cycles+1);
 	    vpi_mcd_printf(1, "Running ...\n");
       }
 
@@ -409,12 +457,17 @@ int vvp_run(const char *design_path)
       schedule_simulate();
 
       if (verbose_flag) {
-	    my_getrusage(cycles+2);
-	    print_rusage(cycles+2, cycles+1);
+	    my_getrusage(cycles+3);
+	    double run_time = print_rusage(cycles+3, cycles+2);
 
 	    vpi_mcd_printf(1, "Event counts:\n");
 	    vpi_mcd_printf(1, "    %8lu time steps (pool=%lu)\n",
 			   count_time_events, count_time_pool());
+	    if (schedule_queue() == SCHED_WHEEL)
+		  vpi_mcd_printf(1, "             ...timing wheel, "
+				 "%lu overflow\n", count_time_overflow);
+	    else
+		  vpi_mcd_printf(1, "             ...sorted list\n");
 	    vpi_mcd_printf(1, "    %8lu thread schedule events\n",
 		    count_thread_events);
 	    vpi_mcd_printf(1, "    %8lu assign events\n",
@@ -431,6 +484,22 @@ int vvp_run(const char *design_path)
 			   count_assign_arword_pool());
 	    vpi_mcd_printf(1, "    %8lu other events (pool=%lu)\n",
 			   count_gen_events, count_gen_pool());
+
+	    unsigned long count_events = count_thread_events
+		  + count_assign_events + count_gen_events;
+	    if (run_time > 0.0)
+		  vpi_mcd_printf(1, "    %8.0f events/second\n",
+				 count_events / run_time);
+
+	    vpi_mcd_printf(1, "Thread instructions:\n");
+	    vpi_mcd_printf(1, "    %8lu executed (%s dispatch)\n",
+			   count_vthread_instructions,
+			   vthread_get_threaded_dispatch()? "threaded" : "call");
+	    if (run_time > 0.0)
+		  vpi_mcd_printf(1, "    %8.0f instructions/second\n",
+				 count_vthread_instructions / run_time);
+	    vpi_mcd_printf(1, "    %8lu vector heap allocations\n",
+			   count_vec4_heap_allocs);
       }
 
       final_cleanup();
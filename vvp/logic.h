@@ -37,6 +37,8 @@ class vvp_fun_boolean_ : public vvp_net_fun_t, protected vvp_gen_event_s {
       void recv_vec4_pv(vvp_net_ptr_t p, const vvp_vector4_t&bit,
 			unsigned base, unsigned vwid, vvp_context_t);
 
+      vvp_gen_event_s* cone_event() { return this; }
+
     protected:
       vvp_vector4_t input_[4];
       vvp_net_t*net_;
@@ -90,6 +92,8 @@ class vvp_fun_buf: public vvp_net_fun_t, private vvp_gen_event_s {
       void recv_vec4_pv(vvp_net_ptr_t p, const vvp_vector4_t&bit,
 			unsigned base, unsigned vwid, vvp_context_t);
 
+      vvp_gen_event_s* cone_event() { return this; }
+
     private:
       void run_run();
 
@@ -154,6 +158,8 @@ class vvp_fun_muxz : public vvp_net_fun_t, private vvp_gen_event_s {
       void recv_vec4_pv(vvp_net_ptr_t p, const vvp_vector4_t&bit,
 			unsigned base, unsigned vwid, vvp_context_t);
 
+      vvp_gen_event_s* cone_event() { return this; }
+
     private:
       void run_run();
 
@@ -176,6 +182,8 @@ class vvp_fun_muxr : public vvp_net_fun_t, private vvp_gen_event_s {
       void recv_real(vvp_net_ptr_t p, double bit,
                      vvp_context_t);
 
+      vvp_gen_event_s* cone_event() { return this; }
+
     private:
       void run_run();
 
@@ -197,6 +205,8 @@ class vvp_fun_not: public vvp_net_fun_t, private vvp_gen_event_s {
       void recv_vec4_pv(vvp_net_ptr_t p, const vvp_vector4_t&bit,
 			unsigned base, unsigned vwid, vvp_context_t);
 
+      vvp_gen_event_s* cone_event() { return this; }
+
     private:
       void run_run();
 
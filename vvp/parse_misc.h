@@ -46,6 +46,13 @@ extern void yyerror(const char*msg);
 
 extern void destroy_lexor();
 
+/*
+ * Open the input file for the lexor, and close it when the parse is
+ * done. lex_open_file returns 0 on success.
+ */
+extern int lex_open_file(const char*path);
+extern void lex_close_file();
+
 /*
  * This is the path of the current source file.
  */
@@ -58,6 +58,8 @@ class vvp_fun_part_sa  : public vvp_fun_part, public vvp_gen_event_s {
       void recv_vec4_pv(vvp_net_ptr_t port, const vvp_vector4_t&bit,
 			unsigned base, unsigned vwid, vvp_context_t);
 
+      vvp_gen_event_s* cone_event() { return this; }
+
     private:
       void run_run();
 
@@ -72,19 +72,14 @@ void resolv_core::recv_vec4_pv_(unsigned port, const vvp_vector4_t&bit,
 void resolv_core::recv_vec8_pv_(unsigned port, const vvp_vector8_t&bit,
 				unsigned base, unsigned vwid)
 {
-      unsigned wid = bit.size();
-      vvp_vector8_t res (vwid);
-
-      for (unsigned idx = 0 ;  idx < base ;  idx += 1)
-	    res.set_bit(idx, vvp_scalar_t());
-
-      for (unsigned idx = 0 ;  idx < wid && idx+base < vwid;  idx += 1)
-	    res.set_bit(idx+base, bit.value(idx));
-
-      for (unsigned idx = base+wid ;  idx < vwid ;  idx += 1)
-	    res.set_bit(idx, vvp_scalar_t());
+	// The bits outside the part are HiZ, which is what
+	// part_expand pads with.
+      if (base >= vwid) {
+	    recv_vec8_(port, vvp_vector8_t(vwid));
+	    return;
+      }
 
-      recv_vec8_(port, res);
+      recv_vec8_(port, part_expand(bit, vwid, base));
 }
 
 
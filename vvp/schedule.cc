@@ -24,7 +24,9 @@
 # include  "vvp_net_sig.h"
 # include  "slab.h"
 # include  "compile.h"
+# include  "cone.h"
 # include  <new>
+# include  <map>
 # include  <typeinfo>
 # include  <csignal>
 # include  <cstdlib>
@@ -51,6 +53,8 @@ unsigned long count_time_events = 0;
  *
  * The event_time_s objects are one per time step. Each time step in
  * turn contains a list of event_s objects that are the actual events.
+ * The time steps are keyed by their absolute simulation time, and are
+ * kept by the scheduler in either a sorted list or a timing wheel.
  *
  * The event_s objects are base classes for the more specific sort of
  * event.
@@ -76,7 +80,7 @@ void event_s::single_step_display(void)
 struct event_time_s {
       event_time_s() {
 	    count_time_events += 1;
-	    delay = 0;
+	    time = 0;
 	    start = 0;
 	    active = 0;
 	    inactive = 0;
@@ -86,7 +90,7 @@ struct event_time_s {
 	    del_thr = 0;
 	    next = NULL;
       }
-      vvp_time64_t delay;
+      vvp_time64_t time;
 
       struct event_s*start;
       struct event_s*active;
@@ -555,12 +559,208 @@ inline void event_time_s::operator delete(void*ptr, size_t)
 unsigned long count_time_pool(void) { return event_time_heap.pool; }
 
 /*
- * This is the head of the list of pending events. This includes all
- * the events that have not been executed yet, and reaches into the
- * future.
+ * This is the current simulation time. All the pending time steps
+ * are at or after this time.
  */
+static vvp_time64_t schedule_time;
+
+/*
+ * The pending time steps are kept in one of two structures, selected
+ * at run time by schedule_select_queue().
+ *
+ * The SCHED_LIST queue is a list of time steps sorted by time. Finding
+ * the time step for a new event walks the list, so it gets expensive
+ * when there are many distinct pending times.
+ *
+ * The SCHED_WHEEL queue (the default) is a timing wheel. The time steps
+ * in the near future, [schedule_time, schedule_time+WHEEL_SIZE), each
+ * have a slot in the wheel_slot table, indexed by the low bits of the
+ * time, and a bit in the wheel_used map so that the next pending time
+ * can be found without visiting empty slots. Time steps further in
+ * the future are kept in the ordered wheel_overflow map, and are moved
+ * into the wheel as the simulation time advances.
+ */
+static schedule_queue_t sched_queue = SCHED_WHEEL;
+
 static struct event_time_s* sched_list = 0;
 
+static const unsigned WHEEL_BITS = 10;
+static const vvp_time64_t WHEEL_SIZE = 1 << WHEEL_BITS;
+static const unsigned WHEEL_MASK = WHEEL_SIZE - 1;
+static const unsigned WHEEL_WORDS = WHEEL_SIZE / 64;
+
+static struct event_time_s* wheel_slot[WHEEL_SIZE];
+static uint64_t wheel_used[WHEEL_WORDS];
+static unsigned long wheel_count = 0;
+static map<vvp_time64_t,struct event_time_s*> wheel_overflow;
+
+unsigned long count_time_overflow = 0;
+
+void schedule_select_queue(schedule_queue_t queue)
+{
+	/* The queue can only be changed while it is empty. */
+      assert(sched_list == 0 && wheel_count == 0 && wheel_overflow.empty());
+      sched_queue = queue;
+}
+
+schedule_queue_t schedule_queue(void)
+{
+      return sched_queue;
+}
+
+static inline unsigned wheel_lowest_bit_(uint64_t word)
+{
+#if defined(__GNUC__)
+      return __builtin_ctzll(word);
+#else
+      unsigned idx = 0;
+      while ((word & 1) == 0) {
+	    word >>= 1;
+	    idx += 1;
+      }
+      return idx;
+#endif
+}
+
+static inline void wheel_insert_(struct event_time_s*ctim)
+{
+      unsigned idx = ctim->time & WHEEL_MASK;
+      assert(wheel_slot[idx] == 0);
+      wheel_slot[idx] = ctim;
+      wheel_used[idx/64] |= (uint64_t)1 << (idx%64);
+      wheel_count += 1;
+}
+
+/*
+ * Find the time step for the given absolute time, creating it if it
+ * does not yet exist.
+ */
+static struct event_time_s* sched_find_time_(vvp_time64_t time)
+{
+      assert(time >= schedule_time);
+
+      if (sched_queue == SCHED_WHEEL) {
+	    if ((time - schedule_time) < WHEEL_SIZE) {
+		  struct event_time_s*ctim = wheel_slot[time & WHEEL_MASK];
+		  if (ctim) {
+			assert(ctim->time == time);
+			return ctim;
+		  }
+		  ctim = new struct event_time_s;
+		  ctim->time = time;
+		  wheel_insert_(ctim);
+		  return ctim;
+	    }
+
+	    map<vvp_time64_t,struct event_time_s*>::iterator cur
+		  = wheel_overflow.lower_bound(time);
+	    if (cur != wheel_overflow.end() && cur->first == time)
+		  return cur->second;
+
+	    struct event_time_s*ctim = new struct event_time_s;
+	    ctim->time = time;
+	    wheel_overflow.insert(cur, make_pair(time, ctim));
+	    count_time_overflow += 1;
+	    return ctim;
+      }
+
+      struct event_time_s*prev = 0;
+      struct event_time_s*ctim = sched_list;
+      while (ctim && (ctim->time < time)) {
+	    prev = ctim;
+	    ctim = ctim->next;
+      }
+
+      if (ctim && (ctim->time == time))
+	    return ctim;
+
+      struct event_time_s*tmp = new struct event_time_s;
+      tmp->time = time;
+      tmp->next = ctim;
+      if (prev)
+	    prev->next = tmp;
+      else
+	    sched_list = tmp;
+
+      return tmp;
+}
+
+/*
+ * Return the earliest pending time step, or nil if there are no
+ * pending events at all.
+ */
+static struct event_time_s* sched_first_(void)
+{
+      if (sched_queue == SCHED_LIST)
+	    return sched_list;
+
+      if (wheel_count == 0) {
+	    if (wheel_overflow.empty())
+		  return 0;
+	    return wheel_overflow.begin()->second;
+      }
+
+	/* All the time steps in the wheel are within WHEEL_SIZE of
+	   the current time, so scanning the used bits starting with
+	   the slot for the current time finds them in time order. */
+      unsigned base = schedule_time & WHEEL_MASK;
+      unsigned word = base / 64;
+      uint64_t bits = wheel_used[word] & (~(uint64_t)0 << (base%64));
+      for (unsigned cnt = 0 ; cnt <= WHEEL_WORDS ; cnt += 1) {
+	    if (bits) {
+		  unsigned idx = word*64 + wheel_lowest_bit_(bits);
+		  return wheel_slot[idx];
+	    }
+	    word = (word + 1) % WHEEL_WORDS;
+	    bits = wheel_used[word];
+      }
+
+      assert(0);
+      return 0;
+}
+
+/*
+ * Advance the current simulation time to the time of the given time
+ * step, which must be the earliest pending time step. This moves any
+ * overflow time steps that now fall within the wheel into the wheel.
+ */
+static void sched_advance_(struct event_time_s*ctim)
+{
+      assert(ctim->time > schedule_time);
+      schedule_time = ctim->time;
+
+      if (sched_queue == SCHED_LIST)
+	    return;
+
+      while (! wheel_overflow.empty()) {
+	    map<vvp_time64_t,struct event_time_s*>::iterator cur
+		  = wheel_overflow.begin();
+	    if ((cur->first - schedule_time) >= WHEEL_SIZE)
+		  break;
+	    wheel_insert_(cur->second);
+	    wheel_overflow.erase(cur);
+      }
+}
+
+/*
+ * Remove the given time step, which must be the earliest pending time
+ * step, from the queue. The caller deletes it.
+ */
+static void sched_remove_first_(struct event_time_s*ctim)
+{
+      if (sched_queue == SCHED_LIST) {
+	    assert(sched_list == ctim);
+	    sched_list = ctim->next;
+	    return;
+      }
+
+      unsigned idx = ctim->time & WHEEL_MASK;
+      assert(wheel_slot[idx] == ctim);
+      wheel_slot[idx] = 0;
+      wheel_used[idx/64] &= ~((uint64_t)1 << (idx%64));
+      wheel_count -= 1;
+}
+
 /*
  * This is a list of initialization events. The setup puts
  * initializations in this list so that they happen before the
@@ -696,57 +896,12 @@ static void schedule_event_(struct event_s*cur, vvp_time64_t delay,
 			    event_queue_t select_queue)
 {
       cur->next = cur;
-      struct event_time_s*ctim = sched_list;
-
-      if (sched_list == 0) {
-	      /* Is the event_time list completely empty? Create the
-		 first event_time object. */
-	    ctim = new struct event_time_s;
-	    ctim->delay = delay;
-	    ctim->next  = 0;
-	    sched_list = ctim;
-
-      } else if (sched_list->delay > delay) {
-
-	      /* Am I looking for an event before the first event_time?
-		 If so, create a new event_time to go in front. */
-	    struct event_time_s*tmp = new struct event_time_s;
-	    tmp->delay = delay;
-	    tmp->next = ctim;
-	    ctim->delay -= delay;
-	    ctim = tmp;
-	    sched_list = ctim;
-
-      } else {
-	    struct event_time_s*prev = 0;
-
-	    while (ctim->next && (ctim->delay < delay)) {
-		  delay -= ctim->delay;
-		  prev = ctim;
-		  ctim = ctim->next;
-	    }
-
-	    if (ctim->delay > delay) {
-		  struct event_time_s*tmp = new struct event_time_s;
-		  tmp->delay = delay;
-		  tmp->next  = prev->next;
-		  prev->next = tmp;
-
-		  tmp->next->delay -= delay;
-		  ctim = tmp;
-
-	    } else if (ctim->delay == delay) {
-
-	    } else {
-		  assert(ctim->next == 0);
-		  struct event_time_s*tmp = new struct event_time_s;
-		  tmp->delay = delay - ctim->delay;
-		  tmp->next = 0;
-		  ctim->next = tmp;
-
-		  ctim = tmp;
-	    }
-      }
+	/* A delay so large that the sum wraps is put at the end of
+	   time instead, which it can never actually reach. */
+      vvp_time64_t time = schedule_time + delay;
+      if (time < schedule_time)
+	    time = ~(vvp_time64_t)0;
+      struct event_time_s*ctim = sched_find_time_(time);
 
 	/* By this point, ctim is the event_time structure that is to
 	   receive the event at hand. Put the event in to the
@@ -797,12 +952,7 @@ static void schedule_event_(struct event_s*cur, vvp_time64_t delay,
 
 static void schedule_event_push_(struct event_s*cur)
 {
-      if ((sched_list == 0) || (sched_list->delay > 0)) {
-	    schedule_event_(cur, 0, SEQ_ACTIVE);
-	    return;
-      }
-
-      struct event_time_s*ctim = sched_list;
+      struct event_time_s*ctim = sched_find_time_(schedule_time);
 
       if (ctim->active == 0) {
 	    cur->next = cur;
@@ -1036,6 +1186,11 @@ static bool sim_started;
 
 void schedule_functor(vvp_gen_event_t obj)
 {
+      if (obj->cone) {
+	    obj->cone->mark(obj->cone_idx);
+	    return;
+      }
+
       struct generic_event_s*cur = new generic_event_s;
 
       cur->obj = obj;
@@ -1070,7 +1225,6 @@ void schedule_at_end_of_simtime(vvp_gen_event_t obj, vvp_time64_t delay)
       schedule_event_(cur, delay, SEQ_RWSYNC);
 }
 
-static vvp_time64_t schedule_time;
 vvp_time64_t schedule_simtime(void)
 { return schedule_time; }
 
@@ -1176,7 +1330,7 @@ void schedule_simulate(void)
       // process events and when done run the final blocks.
       run_finals = schedule_runnable;
 
-      if (schedule_runnable) while (sched_list) {
+      if (schedule_runnable) while (struct event_time_s*ctim = sched_first_()) {
 
 	    if (schedule_stopped_flag) {
 		  schedule_stopped_flag = false;
@@ -1186,22 +1340,19 @@ void schedule_simulate(void)
 		  continue;
 	    }
 
-	      /* ctim is the current time step. */
-	    struct event_time_s* ctim = sched_list;
-
-	      /* If the time is advancing, then first run the
-		 postponed sync events. Run them all. */
-	    if (ctim->delay > 0) {
+	      /* ctim is the current time step. If the time is
+		 advancing, then first run the postponed sync
+		 events. Run them all. */
+	    if (ctim->time > schedule_time) {
 
 		  if (!schedule_runnable) break;
-		  schedule_time += ctim->delay;
+		  sched_advance_(ctim);
 		    /* When the design is being traced (we are emitting
 		     * file/line information) also print any time changes. */
 		  if (show_file_line) {
 			cerr << "Advancing to simulation time: "
 			     << schedule_time << endl;
 		  }
-		  ctim->delay = 0;
 
 		  vpiNextSimTime();
 		    // Process the cbAtStartOfSimTime callbacks.
@@ -1238,7 +1389,7 @@ void schedule_simulate(void)
 				   deletes threads as needed. */
 			      if (ctim->active == 0) {
 				    run_rosync(ctim);
-				    sched_list = ctim->next;
+				    sched_remove_first_(ctim);
 				    delete ctim;
 				    continue;
 			      }
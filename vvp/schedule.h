@@ -150,6 +150,9 @@ extern void schedule_generic(vvp_gen_event_t obj, vvp_time64_t delay,
  * ACTIVE event with a delay of 0. It is up to the user to allocate/free
  * the vvp_get_event_s object. The object is never referenced by the
  * scheduler after the run method is called.
+ *
+ * If the object is a member of a combinational cone (see cone.h) then
+ * it is marked in its cone, and the cone is scheduled instead.
 */
 extern void schedule_functor(vvp_gen_event_t obj);
 
@@ -161,11 +164,28 @@ extern void schedule_del_thr(vthread_t thr);
 
 struct vvp_gen_event_s
 {
+      vvp_gen_event_s() : cone(0), cone_idx(0) { }
       virtual ~vvp_gen_event_s() =0;
       virtual void run_run() =0;
       virtual void single_step_display(void);
+
+	// The combinational cone that evaluates this event, if any,
+	// and the position of this event in that cone.
+      class vvp_cone_s*cone;
+      unsigned cone_idx;
 };
 
+/*
+ * Select the data structure that holds the pending time steps. The
+ * SCHED_WHEEL queue is the default, and is much faster than the
+ * SCHED_LIST queue when there are many distinct pending delays. The
+ * queue can only be selected before any events are scheduled.
+ */
+enum schedule_queue_t { SCHED_LIST, SCHED_WHEEL };
+
+extern void schedule_select_queue(schedule_queue_t queue);
+extern schedule_queue_t schedule_queue(void);
+
 /*
  * This runs the simulator. It runs until all the functors run out or
  * the simulation is otherwise finished.
@@ -35,5 +35,11 @@ unsigned long count_vpi_nets = 0;
 
 unsigned long count_vpi_scopes = 0;
 
+/*
+ * This is a count of the times a vvp_vector4_t needed heap storage
+ * for its bits.
+ */
+unsigned long count_vec4_heap_allocs = 0;
+
 size_t size_opcodes = 0;
 
@@ -27,6 +27,8 @@
 #endif
 
 extern unsigned long count_opcodes;
+extern unsigned long count_fused_cmp;
+extern unsigned long count_fused_addi;
 extern unsigned long count_functors;
 extern unsigned long count_functors_logic;
 extern unsigned long count_functors_bufif;
@@ -34,6 +36,9 @@ extern unsigned long count_functors_resolv;
 extern unsigned long count_functors_sig;
 extern unsigned long count_filters;
 extern unsigned long count_vvp_nets;
+extern void count_net_partitions(unsigned long&parts, unsigned long&largest);
+extern unsigned long count_cones;
+extern unsigned long count_cone_functors;
 extern unsigned long count_vpi_nets;
 extern unsigned long count_vpi_scopes;
 
@@ -41,11 +46,13 @@ extern unsigned long count_net_arrays;
 extern unsigned long count_net_array_words;
 extern unsigned long count_var_arrays;
 extern unsigned long count_var_array_words;
+extern unsigned long count_sparse_arrays;
 extern unsigned long count_real_arrays;
 extern unsigned long count_real_array_words;
 
 
 extern unsigned long count_time_events;
+extern unsigned long count_time_overflow;
 extern unsigned long count_time_pool(void);
 
 extern unsigned long count_assign_events;
@@ -58,6 +65,9 @@ extern unsigned long count_assign_arword_pool(void);
 extern unsigned long count_gen_events;
 extern unsigned long count_gen_pool(void);
 
+extern unsigned long count_vthread_instructions;
+extern unsigned long count_vec4_heap_allocs;
+
 extern size_t size_opcodes;
 extern size_t size_vvp_nets;
 extern size_t size_vvp_net_funs;
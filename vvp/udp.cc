@@ -120,6 +120,62 @@ vvp_bit4_t vvp_udp_s::get_init() const
       return init_;
 }
 
+/*
+ * Small UDP devices get a lookup table that holds the output for all
+ * the possible input values. The table index treats each input as a
+ * base 3 digit: 0 for a 0 input, 1 for a 1 input and 2 for x/z. The
+ * index is calculated from the mask1 and maskx bits using the
+ * udp_pow3 table, which maps 8 bits of mask to the sum of 3**n for
+ * all the bits n that are set.
+ */
+static const unsigned UDP_COMB_LOOKUP_PORTS = 8;
+static const unsigned UDP_SEQ_LOOKUP_PORTS = 6;
+static unsigned short udp_pow3[256];
+
+static void udp_pow3_init()
+{
+      if (udp_pow3[1] != 0)
+	    return;
+
+      for (unsigned idx = 1 ;  idx < 256 ;  idx += 1) {
+	    unsigned val = 0, pow = 1;
+	    for (unsigned bit = 0 ;  bit < 8 ;  bit += 1, pow *= 3) {
+		  if (idx & (1U << bit))
+			val += pow;
+	    }
+	    udp_pow3[idx] = val;
+      }
+}
+
+static inline unsigned udp_lookup_index(const udp_levels_table&cur)
+{
+      return udp_pow3[cur.mask1 & 0xff] + 2*udp_pow3[cur.maskx & 0xff];
+}
+
+  // Make the levels table for the given base 3 index.
+static udp_levels_table udp_lookup_levels(unsigned index, unsigned ndigits)
+{
+      udp_levels_table cur;
+      cur.mask0 = 0;
+      cur.mask1 = 0;
+      cur.maskx = 0;
+      for (unsigned pp = 0 ;  pp < ndigits ;  pp += 1, index /= 3) {
+	    unsigned long mask_bit = 1UL << pp;
+	    switch (index % 3) {
+		case 0:
+		  cur.mask0 |= mask_bit;
+		  break;
+		case 1:
+		  cur.mask1 |= mask_bit;
+		  break;
+		default:
+		  cur.maskx |= mask_bit;
+		  break;
+	    }
+      }
+      return cur;
+}
+
 vvp_udp_comb_s::vvp_udp_comb_s(char*label, char*name__, unsigned ports)
 : vvp_udp_s(label, name__, ports, BIT4_X, false)
 {
@@ -127,12 +183,14 @@ vvp_udp_comb_s::vvp_udp_comb_s(char*label, char*name__, unsigned ports)
       levels1_ = 0;
       nlevels0_ = 0;
       nlevels1_ = 0;
+      lookup_ = 0;
 }
 
 vvp_udp_comb_s::~vvp_udp_comb_s()
 {
       delete[] levels0_;
       delete[] levels1_;
+      delete[] lookup_;
 }
 
 /*
@@ -190,6 +248,9 @@ vvp_bit4_t vvp_udp_comb_s::calculate_output(const udp_levels_table&cur,
 					    const udp_levels_table&,
 					    vvp_bit4_t)
 {
+      if (lookup_)
+	    return (vvp_bit4_t) lookup_[udp_lookup_index(cur)];
+
       return test_levels(cur);
 }
 
@@ -292,6 +353,22 @@ void vvp_udp_comb_s::compile_table(char**tab)
 
       assert(nrows0 == nlevels0_);
       assert(nrows1 == nlevels1_);
+
+	/* Now that the rows are compiled, use them to calculate the
+	   output for every possible input of a small device. */
+      if (port_count() <= UDP_COMB_LOOKUP_PORTS) {
+	    udp_pow3_init();
+	    unsigned nentries = 1;
+	    for (unsigned pp = 0 ;  pp < port_count() ;  pp += 1)
+		  nentries *= 3;
+
+	    lookup_ = new unsigned char[nentries];
+	    for (unsigned idx = 0 ;  idx < nentries ;  idx += 1) {
+		  udp_levels_table cur = udp_lookup_levels(idx, port_count());
+		  assert(udp_lookup_index(cur) == idx);
+		  lookup_[idx] = test_levels(cur);
+	    }
+      }
 }
 
 vvp_udp_seq_s::vvp_udp_seq_s(char*label, char*name__,
@@ -315,6 +392,8 @@ vvp_udp_seq_s::vvp_udp_seq_s(char*label, char*name__,
       nedges0_ = 0;
       nedges1_ = 0;
       nedgesL_ = 0;
+
+      lookup_ = 0;
 }
 
 vvp_udp_seq_s::~vvp_udp_seq_s()
@@ -326,6 +405,7 @@ vvp_udp_seq_s::~vvp_udp_seq_s()
       delete[] edges0_;
       delete[] edges1_;
       delete[] edgesL_;
+      delete[] lookup_;
 }
 
 void edge_based_on_char(struct udp_edges_table&cur, char chr, unsigned pos)
@@ -672,6 +752,73 @@ void vvp_udp_seq_s::compile_table(char**tab)
       assert(idx_edg1 == nedges1_);
       assert(idx_edgL == nedgesL_);
 
+      if (port_count() <= UDP_SEQ_LOOKUP_PORTS)
+	    compile_lookup_();
+}
+
+/*
+ * The lookup table of a sequential UDP is indexed by the current
+ * inputs and output (the output is the last base 3 digit), the input
+ * that changed, and the previous value of that input. The previous
+ * value is one of the two values that differ from the current value,
+ * so it is a 0 or 1 offset in the table. Each entry is the result
+ * that calculate_output would produce for that case.
+ */
+void vvp_udp_seq_s::compile_lookup_()
+{
+      udp_pow3_init();
+
+      unsigned npos = port_count();
+      unsigned nstates = 1;
+      for (unsigned pp = 0 ;  pp <= npos ;  pp += 1)
+	    nstates *= 3;
+
+      lookup_ = new unsigned char[nstates*npos*2];
+
+      for (unsigned idx = 0 ;  idx < nstates ;  idx += 1) {
+	    udp_levels_table cur = udp_lookup_levels(idx, npos+1);
+	    assert(udp_lookup_index(cur) == idx);
+
+	    vvp_bit4_t lev = test_levels_(cur);
+
+	    for (unsigned pos = 0 ;  pos < npos ;  pos += 1) {
+		  unsigned long mask_bit = 1UL << pos;
+		  unsigned digit = (cur.mask1 & mask_bit)? 1
+			: (cur.maskx & mask_bit)? 2 : 0;
+
+		  for (unsigned alt = 0 ;  alt < 2 ;  alt += 1) {
+			  // The previous inputs are the current inputs
+			  // with the input at pos changed. They do not
+			  // include the output bit.
+			unsigned prev_digit = (digit + 1 + alt) % 3;
+			udp_levels_table prev;
+			prev.mask0 = cur.mask0 & ~mask_bit;
+			prev.mask1 = cur.mask1 & ~mask_bit;
+			prev.maskx = cur.maskx & ~mask_bit;
+			switch (prev_digit) {
+			    case 0:
+			      prev.mask0 |= mask_bit;
+			      break;
+			    case 1:
+			      prev.mask1 |= mask_bit;
+			      break;
+			    default:
+			      prev.maskx |= mask_bit;
+			      break;
+			}
+			unsigned long out_mask = ~(1UL << npos);
+			prev.mask0 &= out_mask;
+			prev.mask1 &= out_mask;
+			prev.maskx &= out_mask;
+
+			vvp_bit4_t val = lev;
+			if (val == BIT4_Z)
+			      val = test_edges_(cur, prev);
+
+			lookup_[(idx*npos + pos)*2 + alt] = val;
+		  }
+	    }
+      }
 }
 
 bool operator == (const udp_levels_table&a, const udp_levels_table&b)
@@ -692,6 +839,39 @@ vvp_bit4_t vvp_udp_seq_s::calculate_output(const udp_levels_table&cur,
       if (cur == prev)
 	    return cur_out;
 
+	/* If there is a lookup table, and only one input changed
+	   (the usual case), then the lookup table has the answer. */
+      unsigned long diff = (cur.mask0 ^ prev.mask0)
+	    | (cur.mask1 ^ prev.mask1) | (cur.maskx ^ prev.maskx);
+      if (lookup_ && (diff & (diff-1)) == 0) {
+	    unsigned pos = 0;
+	    while ((diff & 1) == 0) {
+		  diff >>= 1;
+		  pos += 1;
+	    }
+	    unsigned long mask_bit = 1UL << pos;
+	    unsigned digit = (cur.mask1 & mask_bit)? 1
+		  : (cur.maskx & mask_bit)? 2 : 0;
+	    unsigned prev_digit = (prev.mask1 & mask_bit)? 1
+		  : (prev.maskx & mask_bit)? 2 : 0;
+	    unsigned alt = prev_digit == (digit+1) % 3 ? 0 : 1;
+
+	    unsigned npos = port_count();
+	    unsigned idx = udp_lookup_index(cur);
+	    switch (cur_out) {
+		case BIT4_0:
+		  break;
+		case BIT4_1:
+		  idx += udp_pow3[1 << npos];
+		  break;
+		default:
+		  idx += 2*udp_pow3[1 << npos];
+		  break;
+	    }
+
+	    return (vvp_bit4_t) lookup_[(idx*npos + pos)*2 + alt];
+      }
+
       udp_levels_table cur_tmp = cur;
 
       unsigned long mask_out = 1UL << port_count();
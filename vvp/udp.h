@@ -119,7 +119,7 @@ class vvp_udp_comb_s : public vvp_udp_s {
       void compile_table(char**tab);
 
 	// Test the cur table with the compiled rows, and return the
-	// bit value that matches.
+	// bit value that matches. This does not use the lookup table.
       vvp_bit4_t test_levels(const udp_levels_table&cur);
 
       vvp_bit4_t calculate_output(const udp_levels_table&cur,
@@ -131,6 +131,11 @@ class vvp_udp_comb_s : public vvp_udp_s {
       struct udp_levels_table*levels0_;
       struct udp_levels_table*levels1_;
       unsigned nlevels0_, nlevels1_;
+
+	// If the device has few enough inputs, this is the output
+	// for every possible input, indexed by the inputs as a base 3
+	// number. Otherwise, it is nil and the rows are scanned.
+      unsigned char*lookup_;
 };
 
 /*
@@ -208,6 +213,11 @@ class vvp_udp_seq_s : public vvp_udp_s {
       struct udp_edges_table*edgesL_;
       unsigned nedges0_, nedges1_, nedgesL_;
 
+	// If the device has few enough inputs, this is the next output
+	// for every current input and output value, for every single
+	// input edge. Otherwise, it is nil and the rows are scanned.
+      unsigned char*lookup_;
+      void compile_lookup_();
 };
 
 /*
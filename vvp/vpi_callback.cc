@@ -236,8 +236,12 @@ class value_part_callback : public value_callback {
       bool test_value_callback_ready(void);
 
     private:
-      char*value_bits_;
-      size_t value_off_;
+      vvp_signal_value*sig_value_;
+	// The canonical bits of the signal that the part select
+	// covers, and their value when the callback last ran.
+      unsigned value_lsb_;
+      unsigned value_wid_;
+      vvp_vector4_t value_bits_;
 };
 
 inline value_part_callback::value_part_callback(p_cb_data data)
@@ -249,48 +253,46 @@ inline value_part_callback::value_part_callback(p_cb_data data)
       vvp_vpi_callback*sig_fil;
       sig_fil = dynamic_cast<vvp_vpi_callback*>(pobj->net->fil);
       assert(sig_fil);
+      sig_value_ = dynamic_cast<vvp_signal_value*>(pobj->net->fil);
+      assert(sig_value_);
+
+	// Only the part of the select that overlaps the signal can
+	// ever change, so clip the watched bits to the signal.
+      int sig_wid = sig_value_->value_size();
+      int lsb = pobj->tbase;
+      int msb = pobj->tbase + (int)pobj->width;
+      if (lsb < 0) lsb = 0;
+      if (msb > sig_wid) msb = sig_wid;
+      if (msb < lsb) msb = lsb;
+      value_lsb_ = lsb;
+      value_wid_ = msb - lsb;
 
-      sig_fil->add_vpi_callback(this);
 	// Get a reference value that can be used to compare with an
-	// updated value. Use the filter get_value to get the value,
-	// and get it in BinStr form so that compares are easy. Note
-	// that the vpiBinStr format has the MSB first, but the tbase
-	// is lsb first.
-      s_vpi_value tmp_value;
-      tmp_value.format = vpiBinStrVal;
-      sig_fil->get_value(&tmp_value);
-
-      value_bits_ = new char[pobj->width+1];
-      value_off_ = pobj->parent->vpi_get(vpiSize) - pobj->width - pobj->tbase;
-
-      memcpy(value_bits_, tmp_value.value.str + value_off_, pobj->width);
-      value_bits_[pobj->width] = 0;
+	// updated value.
+      vvp_vector4_t tmp;
+      sig_value_->vec4_value(tmp);
+      value_bits_ = tmp.subvalue(value_lsb_, value_wid_);
+
+      if (value_wid_ > 0)
+	    sig_fil->add_vpi_callback(this, value_lsb_, value_lsb_+value_wid_-1);
+      else
+	    sig_fil->add_vpi_callback(this, 1, 0);
 }
 
 value_part_callback::~value_part_callback()
 {
-      delete[]value_bits_;
 }
 
 bool value_part_callback::test_value_callback_ready(void)
 {
-      struct __vpiPV*pobj = dynamic_cast<__vpiPV*>(cb_data.obj);
-      assert(pobj);
-
-      vvp_vpi_callback*sig_fil;
-      sig_fil = dynamic_cast<vvp_vpi_callback*>(pobj->net->fil);
-      assert(sig_fil);
+      vvp_vector4_t tmp;
+      sig_value_->vec4_value(tmp);
+      vvp_vector4_t bits = tmp.subvalue(value_lsb_, value_wid_);
 
-	// Get a reference value that can be used to compare with an
-	// updated value.
-      s_vpi_value tmp_value;
-      tmp_value.format = vpiBinStrVal;
-      sig_fil->get_value(&tmp_value);
-
-      if (memcmp(value_bits_, tmp_value.value.str + value_off_, pobj->width) == 0)
+      if (bits.eeq(value_bits_))
 	    return false;
 
-      memcpy(value_bits_, tmp_value.value.str + value_off_, pobj->width);
+      value_bits_ = bits;
       return true;
 }
 
@@ -823,6 +825,66 @@ struct __vpi_array_word {
       unsigned long word;
 };
 
+/*
+ * The value change callbacks of a signal are kept in a contiguous
+ * array, together with the canonical bit range that each callback
+ * watches. The list also keeps the union of those ranges, so that a
+ * change to bits that no callback watches is skipped without looking
+ * at the callbacks at all. Signals without callbacks carry only the
+ * null pointer.
+ *
+ * Removed callbacks (cb_rtn is nil) are reaped lazily, when the list
+ * is run or grows. The running count blocks reaping while callbacks
+ * are executing, because a callback may add to, remove from or
+ * (through vpi_put_value) run the same list.
+ */
+struct __vpi_callback_list {
+      unsigned count;
+      unsigned alloc;
+      unsigned running;
+      unsigned lsb, msb;
+      struct item_t {
+	    value_callback*cb;
+	    unsigned lsb, msb;
+      } items[1];
+};
+
+static inline bool callback_range_hit(unsigned lsb, unsigned msb,
+                                      unsigned base, unsigned wid)
+{
+      if (lsb > msb || wid == 0 || base > msb)
+	    return false;
+      return lsb <= base || (lsb - base) < wid;
+}
+
+static size_t callback_list_size(unsigned alloc)
+{
+      return sizeof(__vpi_callback_list)
+	    + (alloc-1) * sizeof(__vpi_callback_list::item_t);
+}
+
+static void reap_vpi_callbacks(__vpi_callback_list*list)
+{
+      assert(list->running == 0);
+      unsigned out = 0;
+      list->lsb = ~0U;
+      list->msb = 0;
+      for (unsigned idx = 0 ; idx < list->count ; idx += 1) {
+	    __vpi_callback_list::item_t&item = list->items[idx];
+	    if (item.cb->cb_data.cb_rtn == 0) {
+		  item.cb->next = 0;
+		  delete item.cb;
+		  continue;
+	    }
+	    if (item.lsb <= item.msb) {
+		  if (item.lsb < list->lsb) list->lsb = item.lsb;
+		  if (item.msb > list->msb) list->msb = item.msb;
+	    }
+	    list->items[out++] = item;
+      }
+      list->count = out;
+}
+
 vvp_vpi_callback::vvp_vpi_callback()
 {
       vpi_callbacks_ = 0;
@@ -844,20 +906,50 @@ void vvp_vpi_callback::attach_as_word(vvp_array_t arr, unsigned long addr)
       array_words_ = tmp;
 }
 
-void vvp_vpi_callback::add_vpi_callback(value_callback*cb)
+void vvp_vpi_callback::add_vpi_callback(value_callback*cb,
+                                        unsigned lsb, unsigned msb)
 {
-      cb->next = vpi_callbacks_;
-      vpi_callbacks_ = cb;
+      __vpi_callback_list*list = vpi_callbacks_;
+
+      if (list == 0) {
+	    list = (__vpi_callback_list*)malloc(callback_list_size(1));
+	    list->count = 0;
+	    list->alloc = 1;
+	    list->running = 0;
+	    list->lsb = ~0U;
+	    list->msb = 0;
+	    vpi_callbacks_ = list;
+
+      } else if (list->count == list->alloc) {
+	    if (list->running == 0)
+		  reap_vpi_callbacks(list);
+	    if (list->count == list->alloc) {
+		  list->alloc *= 2;
+		  list = (__vpi_callback_list*)
+			realloc(list, callback_list_size(list->alloc));
+		  vpi_callbacks_ = list;
+	    }
+      }
+
+      cb->next = 0;
+      __vpi_callback_list::item_t&item = list->items[list->count++];
+      item.cb = cb;
+      item.lsb = lsb;
+      item.msb = msb;
+      if (lsb <= msb) {
+	    if (lsb < list->lsb) list->lsb = lsb;
+	    if (msb > list->msb) list->msb = msb;
+      }
 }
 
 #ifdef CHECK_WITH_VALGRIND
 void vvp_vpi_callback::clear_all_callbacks()
 {
-      while (vpi_callbacks_) {
-	    value_callback *tmp = dynamic_cast<value_callback*>
-	                            (vpi_callbacks_->next);
-	    delete vpi_callbacks_;
-	    vpi_callbacks_ = tmp;
+      if (vpi_callbacks_) {
+	    for (unsigned idx = 0 ; idx < vpi_callbacks_->count ; idx += 1)
+		  delete vpi_callbacks_->items[idx].cb;
+	    free(vpi_callbacks_);
+	    vpi_callbacks_ = 0;
       }
       while (array_words_) {
 	    struct __vpi_array_word*tmp = array_words_->next;
@@ -872,8 +964,13 @@ void vvp_vpi_callback::clear_all_callbacks()
  * has a value change. If the cb_rtn is non-nil, then call the
  * callback function. If the cb_rtn pointer is nil, then the object
  * has been marked for deletion. Free it.
+ *
+ * The callbacks are run newest first, and callbacks that are added
+ * while the list is running are not run for this change. The list
+ * may be reallocated by a callback, so it is fetched again after
+ * each one.
  */
-void vvp_vpi_callback::run_vpi_callbacks()
+void vvp_vpi_callback::run_vpi_callbacks(unsigned base, unsigned wid)
 {
       struct __vpi_array_word*array_word = array_words_;
       while (array_word) {
@@ -881,33 +978,40 @@ void vvp_vpi_callback::run_vpi_callbacks()
 	    array_word = array_word->next;
       }
 
-      value_callback *next = vpi_callbacks_;
-      value_callback *prev = 0;
-
-      while (next) {
-	    value_callback*cur = next;
-	    next = dynamic_cast<value_callback*>(cur->next);
-
-	    if (cur->cb_data.cb_rtn != 0) {
-		  if (cur->test_value_callback_ready()) {
-			if (cur->cb_data.value)
-			      get_value(cur->cb_data.value);
+      __vpi_callback_list*list = vpi_callbacks_;
+      if (list == 0)
+	    return;
+      if (!callback_range_hit(list->lsb, list->msb, base, wid))
+	    return;
 
-			callback_execute(cur);
-		  }
-		  prev = cur;
+      bool reap_flag = false;
+      list->running += 1;
+      for (unsigned idx = list->count ; idx > 0 ; idx -= 1) {
+	    __vpi_callback_list::item_t&item = vpi_callbacks_->items[idx-1];
+	    value_callback*cur = item.cb;
 
-	    } else if (prev == 0) {
+	    if (cur->cb_data.cb_rtn == 0) {
+		  reap_flag = true;
+		  continue;
+	    }
+	    if (!callback_range_hit(item.lsb, item.msb, base, wid))
+		  continue;
 
-		  vpi_callbacks_ = next;
-		  cur->next = 0;
-		  delete cur;
+	    if (cur->test_value_callback_ready()) {
+		  if (cur->cb_data.value)
+			get_value(cur->cb_data.value);
 
-	    } else {
-		  assert(prev->next == cur);
-		  prev->next = next;
-		  cur->next = 0;
-		  delete cur;
+		  callback_execute(cur);
+	    }
+      }
+      list = vpi_callbacks_;
+      list->running -= 1;
+
+      if (reap_flag && list->running == 0) {
+	    reap_vpi_callbacks(list);
+	    if (list->count == 0) {
+		  free(list);
+		  vpi_callbacks_ = 0;
 	    }
       }
 }
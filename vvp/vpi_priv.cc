@@ -24,6 +24,8 @@
 # include  "logic.h"
 # include  "part.h"
 # include  "concat.h"
+# include  "vvp_net_sig.h"
+# include  "vvp_darray.h"
 #ifdef CHECK_WITH_VALGRIND
 # include  "vvp_cleanup.h"
 #endif
@@ -1214,6 +1216,96 @@ vpiHandle vpi_put_value(vpiHandle obj, s_vpi_value*vp,
       return 0;
 }
 
+/*
+ * The batched value functions move the values of many objects as
+ * raw aval/bval words. Signals are copied straight from their vector
+ * value, and part selects and memory words go through their
+ * vpiVectorVal get and put methods. Any other object (for example a
+ * real variable or a word of a real array) ends the batch.
+ */
+static bool vpip_is_vector_object(vpiHandle obj)
+{
+      if (dynamic_cast<__vpiSignal*>(obj))
+	    return true;
+
+      switch (obj->get_type_code()) {
+	  case vpiPartSelect:
+	    return true;
+	  case vpiMemoryWord: {
+		__vpiArray*arr = dynamic_cast<__vpiArray*>(obj->vpi_handle(vpiParent));
+		if (arr == 0)
+		      return false;
+		if (arr->vals4)
+		      return true;
+		return arr->vals
+		      && !dynamic_cast<vvp_darray_real*>(arr->vals)
+		      && !dynamic_cast<vvp_darray_string*>(arr->vals);
+	  }
+	  default:
+	    return false;
+      }
+}
+
+extern "C" PLI_INT32 vpip_get_values(PLI_UINT32 count,
+				     const vpiHandle*handles,
+				     s_vpi_vecval*vals)
+{
+      for (PLI_UINT32 idx = 0 ; idx < count ; idx += 1) {
+	    vpiHandle obj = handles[idx];
+	    assert(obj);
+	    if (! vpip_is_vector_object(obj))
+		  return idx;
+
+	    if (__vpiSignal*sig = dynamic_cast<__vpiSignal*>(obj)) {
+		  vvp_signal_value*vsig
+			= dynamic_cast<vvp_signal_value*>(sig->node->fil);
+		  unsigned wid = sig->width();
+		  if (vsig && vsig->value_size() == wid) {
+			vvp_vector4_t tmp;
+			vsig->vec4_value(tmp);
+			tmp.get_vecval(vals);
+			vals += (wid + 31) / 32;
+			continue;
+		  }
+	    }
+
+	    s_vpi_value val;
+	    val.format = vpiVectorVal;
+	    obj->vpi_get_value(&val);
+	    unsigned hwid = (obj->vpi_get(vpiSize) + 31) / 32;
+	    memcpy(vals, val.value.vector, hwid * sizeof(s_vpi_vecval));
+	    vals += hwid;
+      }
+
+      return count;
+}
+
+extern "C" PLI_INT32 vpip_put_values(PLI_UINT32 count,
+				     const vpiHandle*handles,
+				     const s_vpi_vecval*vals)
+{
+      if (schedule_at_rosync()) {
+            fprintf(stderr, "VPI error: attempted to put values "
+			    "during a read-only synch callback.\n");
+            return 0;
+      }
+
+      for (PLI_UINT32 idx = 0 ; idx < count ; idx += 1) {
+	    vpiHandle obj = handles[idx];
+	    assert(obj);
+	    if (! vpip_is_vector_object(obj))
+		  return idx;
+
+	    s_vpi_value val;
+	    val.format = vpiVectorVal;
+	    val.value.vector = const_cast<s_vpi_vecval*>(vals);
+	    obj->vpi_put_value(&val, vpiNoDelay);
+	    vals += (obj->vpi_get(vpiSize) + 31) / 32;
+      }
+
+      return count;
+}
+
 vpiHandle vpi_handle(PLI_INT32 type, vpiHandle ref)
 {
       vpiHandle res = 0;
@@ -1344,6 +1436,12 @@ static vpiHandle find_name(const char *name, vpiHandle handle)
       if (!strcmp(name, vpi_get_str(vpiName, handle)))
 	    rtn = handle;
 
+      /* The name index has everything but the memory words, which
+       * are only found by the search below. */
+      vpiHandle item = ref->find_item(name);
+      if (item) return item;
+      if (strchr(name, '[') == 0) return rtn;
+
       /* brute force search for the name in all objects in this scope */
       for (unsigned i = 0 ;  i < ref->intern.size() ;  i += 1) {
 	      /* The standard says that since a port does not have a full
@@ -1401,11 +1499,6 @@ static char * find_rest(char *name)
 
 static vpiHandle find_scope(const char *name, vpiHandle handle, int depth)
 {
-
-      vpiHandle iter = handle==0
-	    ? vpi_iterate(vpiModule, NULL)
-	    : vpi_iterate(vpiInternalScope, handle);
-
       vector<char> name_buf (strlen(name)+1);
       strcpy(&name_buf[0], name);
       char*nm_first = &name_buf[0];
@@ -1415,26 +1508,20 @@ static vpiHandle find_scope(const char *name, vpiHandle handle, int depth)
 	    *nm_rest++ = 0;
       }
 
-      vpiHandle rtn = 0;
+	/* Each part of the path is looked up in the name index of the
+	   scope, or of the root table for the first part. */
       vpiHandle hand;
-      while (iter && (hand = vpi_scan(iter))) {
-	    char *nm = vpi_get_str(vpiName, hand);
-
-	    if (strcmp(nm_first,nm)==0) {
-		  if (nm_rest)
-			rtn=find_scope(nm_rest, hand, depth+1);
-		  else
-			rtn = hand;
-	    }
-
-	    /* found it yet ? */
-	    if (rtn) {
-		  vpi_free_object(iter);
-		  break;
-	    }
+      if (handle == 0) {
+	    hand = vpip_find_root_module(nm_first);
+      } else {
+	    __vpiScope*ref = dynamic_cast<__vpiScope*>(handle);
+	    hand = ref ? ref->find_internal_scope(nm_first) : 0;
       }
 
-      return rtn;
+      if (hand && nm_rest)
+	    hand = find_scope(nm_rest, hand, depth+1);
+
+      return hand;
 }
 
 // Find the end of the first escaped identifier or simple identifier
@@ -2031,5 +2118,9 @@ vpip_routines_s vpi_routines = {
     .make_systf_system_defined  = vpip_make_systf_system_defined,
     .mcd_rawwrite               = vpip_mcd_rawwrite,
     .set_return_value           = vpip_set_return_value,
+    .put_array_words            = vpip_put_array_words,
+    .get_array_words            = vpip_get_array_words,
+    .put_values                 = vpip_put_values,
+    .get_values                 = vpip_get_values,
 };
 #endif
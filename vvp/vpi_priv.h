@@ -255,6 +255,7 @@ struct __vpiScopedRealtime : public __vpiSystemTime {
 class __vpiScope : public __vpiHandle {
 
     public:
+      ~__vpiScope();
       int vpi_get(int code);
       char* vpi_get_str(int code);
       vpiHandle vpi_handle(int code);
@@ -269,6 +270,12 @@ class __vpiScope : public __vpiHandle {
 	// TRUE if this is an automatic func/task/block
       inline bool is_automatic() const { return is_automatic_; }
 
+	// Find an item (other than a port) or an internal scope of
+	// this scope by its base name. The names are kept in a hash
+	// index that is built the first time it is needed.
+      vpiHandle find_item(const char*name);
+      vpiHandle find_internal_scope(const char*name);
+
     public:
       __vpiScope *scope;
       unsigned file_idx;
@@ -305,6 +312,8 @@ class __vpiScope : public __vpiHandle {
       const char*tname_;
 	/* the scope may be "automatic" */
       bool is_automatic_;
+	/* Index of the intern items by name, or nil if not built. */
+      class vpip_name_index*name_index_;
 };
 
 class vpiScopeFunction  : public __vpiScope {
@@ -342,6 +351,7 @@ extern __vpiScope* vpip_peek_context_scope(void);
 extern unsigned vpip_add_item_to_context(automatic_hooks_s*item,
                                          __vpiScope*scope);
 extern vpiHandle vpip_make_root_iterator(int type_code);
+extern vpiHandle vpip_find_root_module(const char*name);
 extern void vpip_make_root_iterator(class __vpiHandle**&table,
 				    unsigned&ntable);
 
@@ -764,7 +774,8 @@ struct __vpiArrayBase {
 * - Array of vector4 words.
 * In this case, the nets pointer is nil, and the vals4 member points
 * to a vvl_vector4array_t object that is a compact representation of
-* an array of vvp_vector4_t vectors.
+* an array of vvp_vector4_t vectors. Very large arrays use the sparse
+* vvp_vector4array_sp, which only allocates the pages that are written.
 *
 * - Array of real variables
 * The vals member points to a dynamic array objects that has an
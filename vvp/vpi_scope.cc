@@ -26,6 +26,8 @@
 # include  "vvp_cleanup.h"
 #endif
 # include  <vector>
+# include  <string>
+# include  <unordered_map>
 # include  <cstring>
 # include  <cstdlib>
 # include  <cassert>
@@ -36,6 +38,74 @@ using namespace std;
 static vector<vpiHandle> vpip_root_table;
 
 static vpiHandle make_subset_iterator_(int type_code, vector<vpiHandle>&table);
+static int compare_types(int code, int type);
+
+/*
+ * The name index maps the base names of the items in a table (the
+ * intern items of a scope, or the root table) to the first item with
+ * that name. Items are only ever appended to these tables, so the
+ * index only needs to add the items that are new since the last
+ * lookup. Ports have no full name, so they cannot be found by name
+ * and are not indexed.
+ */
+class vpip_name_index {
+    public:
+      vpip_name_index() : count_(0) { }
+      vpiHandle find(const char*name, const vector<vpiHandle>&table);
+
+    private:
+      unordered_map<string,vpiHandle> map_;
+      size_t count_;
+};
+
+vpiHandle vpip_name_index::find(const char*name, const vector<vpiHandle>&table)
+{
+	/* The table was cleared, so start over. */
+      if (count_ > table.size()) {
+	    map_.clear();
+	    count_ = 0;
+      }
+
+      for ( ; count_ < table.size() ; count_ += 1) {
+	    vpiHandle item = table[count_];
+	    if (item->get_type_code() == vpiPort) continue;
+	    const char*nm = item->vpi_get_str(vpiName);
+	    if (nm) map_.insert(make_pair(string(nm), item));
+      }
+
+      unordered_map<string,vpiHandle>::const_iterator cur = map_.find(name);
+      return cur == map_.end() ? 0 : cur->second;
+}
+
+/*
+ * Find the first item in the table with the given name that is of
+ * the given iterator type. This is only used when the first item
+ * with the name is of some other type.
+ */
+static vpiHandle find_by_type_(const char*name, int type_code,
+			       const vector<vpiHandle>&table)
+{
+      for (unsigned idx = 0 ; idx < table.size() ; idx += 1) {
+	    vpiHandle item = table[idx];
+	    if (! compare_types(type_code, item->get_type_code()))
+		  continue;
+	    const char*nm = item->vpi_get_str(vpiName);
+	    if (nm && strcmp(nm, name) == 0)
+		  return item;
+      }
+      return 0;
+}
+
+static vpip_name_index root_name_index;
+
+vpiHandle vpip_find_root_module(const char*name)
+{
+      vpiHandle item = root_name_index.find(name, vpip_root_table);
+      if (item == 0 || item->get_type_code() == vpiModule)
+	    return item;
+
+      return find_by_type_(name, vpiModule, vpip_root_table);
+}
 
 vpiHandle vpip_make_root_iterator(int type_code)
 {
@@ -350,12 +420,34 @@ static vpiHandle module_iter(int code, vpiHandle obj)
 
 
 __vpiScope::__vpiScope(const char*nam, const char*tnam, bool auto_flag)
-: is_automatic_(auto_flag)
+: is_automatic_(auto_flag), name_index_(0)
 {
       name_ = vpip_name_string(nam);
       tname_ = vpip_name_string(tnam? tnam : "");
 }
 
+__vpiScope::~__vpiScope()
+{
+      delete name_index_;
+}
+
+vpiHandle __vpiScope::find_item(const char*name)
+{
+      if (name_index_ == 0)
+	    name_index_ = new vpip_name_index;
+
+      return name_index_->find(name, intern);
+}
+
+vpiHandle __vpiScope::find_internal_scope(const char*name)
+{
+      vpiHandle obj = find_item(name);
+      if (obj == 0 || compare_types(vpiInternalScope, obj->get_type_code()))
+	    return obj;
+
+      return find_by_type_(name, vpiInternalScope, intern);
+}
+
 int __vpiScope::vpi_get(int code)
 {
       switch (code) {
@@ -176,6 +176,28 @@ static void format_vpiBinStrVal(vvp_signal_value*sig, int base, unsigned wid,
       vp->value.str = rbuf;
 }
 
+/*
+ * This is the same as format_vpiBinStrVal for a whole vector signal,
+ * but it gets the value of the signal in one step instead of calling
+ * the value() method for each bit. Waveform dumpers get the value of
+ * every signal that changes this way, so this matters.
+ */
+static void format_vpiBinStrVal_whole(vvp_signal_value*sig, unsigned wid,
+                                      s_vpi_value*vp)
+{
+	// Keep the vector around so that its storage is reused.
+      static vvp_vector4_t val;
+      sig->vec4_value(val);
+      assert(val.size() == wid);
+
+      char *rbuf = (char *) need_result_buf(wid+1, RBUF_VAL);
+      for (unsigned idx = 0 ;  idx < wid ;  idx += 1)
+	    rbuf[wid-1-idx] = vvp_bit4_to_ascii(val.value(idx));
+      rbuf[wid] = 0;
+
+      vp->value.str = rbuf;
+}
+
 static void format_vpiOctStrVal(vvp_signal_value*sig, int base, unsigned wid,
                                 s_vpi_value*vp)
 {
@@ -501,30 +523,43 @@ static void format_vpiVectorVal(vvp_signal_value*sig, int base, unsigned wid,
                          need_result_buf(hwid * sizeof(s_vpi_vecval), RBUF_VAL);
       vp->value.vector = op;
 
+	// If all the bits are within the signal, copy the words
+	// straight out of its vector value.
+      if (base >= 0 && end <= (signed)sig->value_size()) {
+	    vvp_vector4_t tmp;
+	    sig->vec4_value(tmp);
+	    if (base == 0 && wid == tmp.size())
+		  tmp.get_vecval(op);
+	    else
+		  tmp.subvalue(base, wid).get_vecval(op);
+	    return;
+      }
+
       op->aval = op->bval = 0;
       for (long idx = base ;  idx < end ;  idx += 1) {
-	    if (base >= 0 && base < (signed)sig->value_size()) {
+	    const PLI_UINT32 mask = 1U << obit;
+	    if (idx >= 0 && idx < (signed)sig->value_size()) {
 		switch (sig->value(idx)) {
 		case BIT4_0:
-		  op->aval &= ~(1 << obit);
-		  op->bval &= ~(1 << obit);
+		  op->aval &= ~mask;
+		  op->bval &= ~mask;
 		  break;
 		case BIT4_1:
-		  op->aval |= (1 << obit);
-		  op->bval &= ~(1 << obit);
+		  op->aval |= mask;
+		  op->bval &= ~mask;
 		  break;
 		case BIT4_X:
-		  op->aval |= (1 << obit);
-		  op->bval |= (1 << obit);
+		  op->aval |= mask;
+		  op->bval |= mask;
 		  break;
 		case BIT4_Z:
-		  op->aval &= ~(1 << obit);
-		  op->bval |= (1 << obit);
+		  op->aval &= ~mask;
+		  op->bval |= mask;
 		  break;
 		}
 	    } else {  /* BIT4_X */
-		  op->aval |= (1 << obit);
-		  op->bval |= (1 << obit);
+		  op->aval |= mask;
+		  op->bval |= mask;
 	    }
 
 	    obit++;
@@ -862,7 +897,10 @@ static void signal_get_value(vpiHandle ref, s_vpi_value*vp)
 	    break;
 
 	  case vpiBinStrVal:
-	    format_vpiBinStrVal(vsig, 0, wid, vp);
+	    if (wid == vsig->value_size())
+		  format_vpiBinStrVal_whole(vsig, wid, vp);
+	    else
+		  format_vpiBinStrVal(vsig, 0, wid, vp);
 	    break;
 
 	  case vpiHexStrVal:
@@ -1003,15 +1041,7 @@ vvp_vector4_t vec4_from_vpi_value(s_vpi_value*vp, unsigned wid)
 	  }
 
 	  case vpiVectorVal:
-	    for (unsigned idx = 0 ;  idx < wid ;  idx += 1) {
-		  unsigned long aval = vp->value.vector[idx/32].aval;
-		  unsigned long bval = vp->value.vector[idx/32].bval;
-		  aval >>= idx%32;
-		  bval >>= idx%32;
-		  int bitmask = (aval&1) | ((bval<<1)&2);
-		  vvp_bit4_t bit = scalar_to_bit4(bitmask);
-		  val.set_bit(idx, bit);
-	    }
+	    val.set_vecval(vp->value.vector);
 	    break;
 	  case vpiBinStrVal:
 	    vpip_bin_str_to_vec4(val, vp->value.str);
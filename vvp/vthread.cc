@@ -113,44 +113,76 @@ struct vthread_s {
       vector<unsigned> args_vec4;
 
     private:
+	// The vec4 stack does not destroy the vectors that are popped,
+	// but keeps them so that the next push can copy into the storage
+	// they already have. This way pushing a wide vector does not
+	// need to allocate heap storage each time. The stack_vec4_top_
+	// is the number of entries that are actually on the stack.
       vector<vvp_vector4_t>stack_vec4_;
+      unsigned stack_vec4_top_;
     public:
       inline vvp_vector4_t pop_vec4(void)
       {
-	    assert(! stack_vec4_.empty());
-	    vvp_vector4_t val = stack_vec4_.back();
-	    stack_vec4_.pop_back();
-	    return val;
+	    assert(stack_vec4_top_ > 0);
+	    stack_vec4_top_ -= 1;
+	    return std::move(stack_vec4_[stack_vec4_top_]);
       }
       inline void push_vec4(const vvp_vector4_t&val)
       {
-	    stack_vec4_.push_back(val);
+	    if (stack_vec4_top_ < stack_vec4_.size())
+		  stack_vec4_[stack_vec4_top_] = val;
+	    else
+		  stack_vec4_.push_back(val);
+	    stack_vec4_top_ += 1;
+      }
+      inline void push_vec4(vvp_vector4_t&&val)
+      {
+	    if (stack_vec4_top_ < stack_vec4_.size())
+		  stack_vec4_[stack_vec4_top_] = std::move(val);
+	    else
+		  stack_vec4_.push_back(std::move(val));
+	    stack_vec4_top_ += 1;
+      }
+	// Push a vector of the given width and return a reference to
+	// it, so that the caller can write the value in place. The
+	// bits of the new entry are undefined.
+      inline vvp_vector4_t& push_vec4(unsigned wid)
+      {
+	    if (stack_vec4_top_ < stack_vec4_.size())
+		  stack_vec4_[stack_vec4_top_].resize(wid);
+	    else
+		  stack_vec4_.push_back(vvp_vector4_t(wid));
+	    stack_vec4_top_ += 1;
+	    return stack_vec4_[stack_vec4_top_-1];
       }
       inline const vvp_vector4_t& peek_vec4(unsigned depth)
       {
-	    unsigned size = stack_vec4_.size();
-	    assert(depth < size);
-	    unsigned use_index = size-1-depth;
+	    assert(depth < stack_vec4_top_);
+	    unsigned use_index = stack_vec4_top_-1-depth;
 	    return stack_vec4_[use_index];
       }
       inline vvp_vector4_t& peek_vec4(void)
       {
-	    unsigned use_index = stack_vec4_.size();
-	    assert(use_index >= 1);
-	    return stack_vec4_[use_index-1];
+	    assert(stack_vec4_top_ >= 1);
+	    return stack_vec4_[stack_vec4_top_-1];
+      }
+	// Get a reference to the entry under the top of the stack. The
+	// binary operators use this to write the result in place.
+      inline vvp_vector4_t& peek_vec4_under(void)
+      {
+	    assert(stack_vec4_top_ >= 2);
+	    return stack_vec4_[stack_vec4_top_-2];
       }
       inline void poke_vec4(unsigned depth, const vvp_vector4_t&val)
       {
-	    assert(depth < stack_vec4_.size());
-	    unsigned use_index = stack_vec4_.size()-1-depth;
+	    assert(depth < stack_vec4_top_);
+	    unsigned use_index = stack_vec4_top_-1-depth;
 	    stack_vec4_[use_index] = val;
       }
       inline void pop_vec4(unsigned cnt)
       {
-	    while (cnt > 0) {
-		  stack_vec4_.pop_back();
-		  cnt -= 1;
-	    }
+	    assert(cnt <= stack_vec4_top_);
+	    stack_vec4_top_ -= cnt;
       }
 
 
@@ -299,14 +331,14 @@ struct vthread_s {
       inline void cleanup()
       {
 	    if (i_was_disabled) {
-		  stack_vec4_.clear();
+		  stack_vec4_top_ = 0;
 		  stack_real_.clear();
 		  stack_str_.clear();
 		  pop_object(stack_obj_size_);
 	    }
 	    free(filenm_);
 	    filenm_ = 0;
-	    assert(stack_vec4_.empty());
+	    assert(stack_vec4_top_ == 0);
 	    assert(stack_real_.empty());
 	    assert(stack_str_.empty());
 	    assert(stack_obj_size_ == 0);
@@ -315,6 +347,7 @@ struct vthread_s {
 
 inline vthread_s::vthread_s()
 {
+      stack_vec4_top_ = 0;
       stack_obj_size_ = 0;
       filenm_ = 0;
       lineno_ = 0;
@@ -350,8 +383,8 @@ void vthread_s::debug_dump(ostream&fd, const char*label)
 	    fd << flags[idx];
       fd << endl;
       fd << "**** vec4 stack..." << endl;
-      for (size_t idx = stack_vec4_.size() ; idx > 0 ; idx -= 1)
-	    fd << "    " << (stack_vec4_.size()-idx) << ": " << stack_vec4_[idx-1] << endl;
+      for (size_t idx = stack_vec4_top_ ; idx > 0 ; idx -= 1)
+	    fd << "    " << (stack_vec4_top_-idx) << ": " << stack_vec4_[idx-1] << endl;
       fd << "**** str stack (" << stack_str_.size() << ")..." << endl;
       fd << "**** obj stack (" << stack_obj_size_ << ")..." << endl;
       fd << "**** args_vec4 array (" << args_vec4.size() << ")..." << endl;
@@ -852,6 +885,177 @@ void vthread_delay_delete()
 	    running_thread->delay_delete = 1;
 }
 
+/*
+ * This counts the instructions executed by all the threads. The
+ * dispatch loops count in a local variable and add it in here when
+ * they return, to keep the count out of the inner loop.
+ */
+unsigned long count_vthread_instructions = 0;
+
+#if defined(__GNUC__)
+static bool vthread_threaded_dispatch = true;
+#else
+static bool vthread_threaded_dispatch = false;
+#endif
+
+void vthread_set_threaded_dispatch(bool flag)
+{
+#if defined(__GNUC__)
+      vthread_threaded_dispatch = flag;
+#else
+      (void)flag;
+#endif
+}
+
+bool vthread_get_threaded_dispatch(void)
+{
+      return vthread_threaded_dispatch;
+}
+
+#if defined(__GNUC__)
+/*
+ * This is the threaded version of the dispatch loop. Instead of
+ * calling every opcode through the function pointer and returning
+ * here, each instruction carries in its dispatch member the address
+ * of the label in this function that executes it, and every handler
+ * ends by jumping directly to the handler for the next instruction.
+ *
+ * The common opcodes have handlers of their own, which call the
+ * opcode implementation directly so that the compiler can inline it.
+ * All the other opcodes go through the op_call handler. The dispatch
+ * member is filled in by op_resolve the first time an instruction is
+ * executed.
+ */
+static void vthread_run_threaded_(vthread_t thr)
+{
+      static const struct {
+	    vvp_code_fun opcode;
+	    const void*label;
+      } hot_opcodes[] = {
+	    { &of_ADD,          &&op_ADD },
+	    { &of_ADDI,         &&op_ADDI },
+	    { &of_AND,          &&op_AND },
+	    { &of_ASSIGN_VEC4,  &&op_ASSIGN_VEC4 },
+	    { &of_CMPE,         &&op_CMPE },
+	    { &of_CMPIE,        &&op_CMPIE },
+	    { &of_CMPINE,       &&op_CMPINE },
+	    { &of_CMPIS,        &&op_CMPIS },
+	    { &of_CMPIU,        &&op_CMPIU },
+	    { &of_CMPNE,        &&op_CMPNE },
+	    { &of_CMPS,         &&op_CMPS },
+	    { &of_CMPU,         &&op_CMPU },
+	    { &of_DUP_VEC4,     &&op_DUP_VEC4 },
+	    { &of_FLAG_MOV,     &&op_FLAG_MOV },
+	    { &of_FLAG_SET_IMM, &&op_FLAG_SET_IMM },
+	    { &of_FUSE_LOAD_ADDI_STORE, &&op_FUSE_LOAD_ADDI_STORE },
+	    { &of_FUSE_LOAD_CMPIE,      &&op_FUSE_LOAD_CMPIE },
+	    { &of_FUSE_LOAD_CMPINE,     &&op_FUSE_LOAD_CMPINE },
+	    { &of_FUSE_LOAD_SUBI_STORE, &&op_FUSE_LOAD_SUBI_STORE },
+	    { &of_JMP,          &&op_JMP },
+	    { &of_JMP0,         &&op_JMP0 },
+	    { &of_JMP0XZ,       &&op_JMP0XZ },
+	    { &of_JMP1,         &&op_JMP1 },
+	    { &of_JMP1XZ,       &&op_JMP1XZ },
+	    { &of_LOAD_VEC4,    &&op_LOAD_VEC4 },
+	    { &of_OR,           &&op_OR },
+	    { &of_PAD_S,        &&op_PAD_S },
+	    { &of_PAD_U,        &&op_PAD_U },
+	    { &of_POP_VEC4,     &&op_POP_VEC4 },
+	    { &of_PUSHI_VEC4,   &&op_PUSHI_VEC4 },
+	    { &of_STORE_VEC4,   &&op_STORE_VEC4 },
+	    { &of_SUB,          &&op_SUB },
+	    { &of_SUBI,         &&op_SUBI },
+	    { &of_XOR,          &&op_XOR },
+      };
+      static const unsigned hot_count = sizeof hot_opcodes / sizeof hot_opcodes[0];
+
+      unsigned long count = 0;
+      vvp_code_t cp;
+
+	/* Fetch the next instruction and jump to its handler. */
+#define DISPATCH() do {						\
+	    cp = thr->pc;						\
+	    thr->pc += 1;						\
+	    count += 1;							\
+	    goto *(cp->dispatch? cp->dispatch : &&op_resolve);		\
+      } while (0)
+
+	/* Execute an opcode implementation. If it returns false, then
+	   the thread is meant to be paused. */
+#define EXECUTE(fun) do {					\
+	    if (fun(thr, cp)) DISPATCH();				\
+	    goto thread_paused;						\
+      } while (0)
+
+      while (thr != 0) {
+	    vthread_t tmp = thr->wait_next;
+	    thr->wait_next = 0;
+
+	    assert(thr->is_scheduled);
+	    thr->is_scheduled = 0;
+
+            running_thread = thr;
+
+	    DISPATCH();
+
+      op_resolve:
+	    cp->dispatch = &&op_call;
+	    for (unsigned idx = 0 ; idx < hot_count ; idx += 1) {
+		  if (hot_opcodes[idx].opcode == cp->opcode) {
+			cp->dispatch = hot_opcodes[idx].label;
+			break;
+		  }
+	    }
+	    goto *cp->dispatch;
+
+      op_call:         EXECUTE(cp->opcode);
+      op_ADD:          EXECUTE(of_ADD);
+      op_ADDI:         EXECUTE(of_ADDI);
+      op_AND:          EXECUTE(of_AND);
+      op_ASSIGN_VEC4:  EXECUTE(of_ASSIGN_VEC4);
+      op_CMPE:         EXECUTE(of_CMPE);
+      op_CMPIE:        EXECUTE(of_CMPIE);
+      op_CMPINE:       EXECUTE(of_CMPINE);
+      op_CMPIS:        EXECUTE(of_CMPIS);
+      op_CMPIU:        EXECUTE(of_CMPIU);
+      op_CMPNE:        EXECUTE(of_CMPNE);
+      op_CMPS:         EXECUTE(of_CMPS);
+      op_CMPU:         EXECUTE(of_CMPU);
+      op_DUP_VEC4:     EXECUTE(of_DUP_VEC4);
+      op_FLAG_MOV:     EXECUTE(of_FLAG_MOV);
+      op_FLAG_SET_IMM: EXECUTE(of_FLAG_SET_IMM);
+      op_FUSE_LOAD_ADDI_STORE: EXECUTE(of_FUSE_LOAD_ADDI_STORE);
+      op_FUSE_LOAD_CMPIE:      EXECUTE(of_FUSE_LOAD_CMPIE);
+      op_FUSE_LOAD_CMPINE:     EXECUTE(of_FUSE_LOAD_CMPINE);
+      op_FUSE_LOAD_SUBI_STORE: EXECUTE(of_FUSE_LOAD_SUBI_STORE);
+      op_JMP:          EXECUTE(of_JMP);
+      op_JMP0:         EXECUTE(of_JMP0);
+      op_JMP0XZ:       EXECUTE(of_JMP0XZ);
+      op_JMP1:         EXECUTE(of_JMP1);
+      op_JMP1XZ:       EXECUTE(of_JMP1XZ);
+      op_LOAD_VEC4:    EXECUTE(of_LOAD_VEC4);
+      op_OR:           EXECUTE(of_OR);
+      op_PAD_S:        EXECUTE(of_PAD_S);
+      op_PAD_U:        EXECUTE(of_PAD_U);
+      op_POP_VEC4:     EXECUTE(of_POP_VEC4);
+      op_PUSHI_VEC4:   EXECUTE(of_PUSHI_VEC4);
+      op_STORE_VEC4:   EXECUTE(of_STORE_VEC4);
+      op_SUB:          EXECUTE(of_SUB);
+      op_SUBI:         EXECUTE(of_SUBI);
+      op_XOR:          EXECUTE(of_XOR);
+
+      thread_paused:
+	    thr = tmp;
+      }
+      running_thread = 0;
+
+#undef EXECUTE
+#undef DISPATCH
+
+      count_vthread_instructions += count;
+}
+#endif
+
 /*
  * This function runs each thread by fetching an instruction,
  * incrementing the PC, and executing the instruction. The thread may
@@ -859,6 +1063,15 @@ void vthread_delay_delete()
  */
 void vthread_run(vthread_t thr)
 {
+#if defined(__GNUC__)
+      if (vthread_threaded_dispatch) {
+	    vthread_run_threaded_(thr);
+	    return;
+      }
+#endif
+
+      unsigned long count = 0;
+
       while (thr != 0) {
 	    vthread_t tmp = thr->wait_next;
 	    thr->wait_next = 0;
@@ -871,6 +1084,7 @@ void vthread_run(vthread_t thr)
 	    for (;;) {
 		  vvp_code_t cp = thr->pc;
 		  thr->pc += 1;
+		  count += 1;
 
 		    /* Run the opcode implementation. If the execution of
 		       the opcode returns false, then the thread is meant to
@@ -883,6 +1097,8 @@ void vthread_run(vthread_t thr)
 	    thr = tmp;
       }
       running_thread = 0;
+
+      count_vthread_instructions += count;
 }
 
 /*
@@ -962,10 +1178,11 @@ bool of_ALLOC(vthread_t thr, vvp_code_t cp)
 
 bool of_AND(vthread_t thr, vvp_code_t)
 {
-      vvp_vector4_t valb = thr->pop_vec4();
-      vvp_vector4_t&vala = thr->peek_vec4();
+      const vvp_vector4_t&valb = thr->peek_vec4(0);
+      vvp_vector4_t&vala = thr->peek_vec4_under();
       assert(vala.size() == valb.size());
       vala &= valb;
+      thr->pop_vec4(1);
       return true;
 }
 
@@ -1031,14 +1248,15 @@ static void get_immediate_rval(vvp_code_t cp, vvp_vector4_t&val)
  */
 bool of_ADD(vthread_t thr, vvp_code_t)
 {
-      vvp_vector4_t r = thr->pop_vec4();
+      const vvp_vector4_t&r = thr->peek_vec4(0);
 	// Rather then pop l, use it directly from the stack. When we
-	// assign to 'l', that will edit the top of the stack, which
-	// replaces a pop and a pull.
-      vvp_vector4_t&l = thr->peek_vec4();
+	// assign to 'l', that will edit the stack in place, and
+	// popping r then leaves the result on the top.
+      vvp_vector4_t&l = thr->peek_vec4_under();
 
       l.add(r);
 
+      thr->pop_vec4(1);
       return true;
 }
 
@@ -1676,18 +1894,7 @@ bool of_CASSIGN_WR(vthread_t thr, vvp_code_t cp)
 bool of_CAST2(vthread_t thr, vvp_code_t)
 {
       vvp_vector4_t&val = thr->peek_vec4();
-      unsigned wid = val.size();
-
-      for (unsigned idx = 0 ; idx < wid ; idx += 1) {
-	    switch (val.value(idx)) {
-		case BIT4_0:
-		case BIT4_1:
-		  break;
-		default:
-		  val.set_bit(idx, BIT4_0);
-		  break;
-	    }
-      }
+      val.change_xz2zero();
 
       return true;
 }
@@ -3969,12 +4176,6 @@ bool of_LOAD_STRA(vthread_t thr, vvp_code_t cp)
  */
 bool of_LOAD_VEC4(vthread_t thr, vvp_code_t cp)
 {
-	// Push a placeholder onto the stack in order to reserve the
-	// stack space. Use a reference for the stack top as a target
-	// for the load.
-      thr->push_vec4(vvp_vector4_t());
-      vvp_vector4_t&sig_value = thr->peek_vec4();
-
       vvp_net_t*net = cp->net;
 
 	// For the %load to work, the functor must actually be a
@@ -3987,16 +4188,106 @@ bool of_LOAD_VEC4(vthread_t thr, vvp_code_t cp)
 	                        typeid(*net->fun).name())
 	         << endl;
 	    assert(sig);
+	    thr->push_vec4(vvp_vector4_t());
 	    return true;
       }
 
-	// Extract the value from the signal and directly into the
-	// target stack position.
+	// Reserve a stack entry of the right width and extract the
+	// value from the signal directly into it. If the entry already
+	// has storage of the right size, the load reuses it.
+      vvp_vector4_t&sig_value = thr->push_vec4(sig->value_size());
       sig->vec4_value(sig_value);
 
       return true;
 }
 
+/*
+ * These are the fused forms of these sequences:
+ *
+ *    %load/vec4 <net>; %cmpi/e <vala>, <valb>, <wid>
+ *    %load/vec4 <net>; %pushi/vec4 <vala>, <valb>, <wid>; %cmp/e
+ *
+ * (and the /ne forms). The compare is done directly against the
+ * value of the signal and the immediate value in the next
+ * instruction. Nothing is left on the stack. The bit_idx[0] of the
+ * fused instruction is the length of the sequence to skip.
+ */
+static void do_FUSE_LOAD_CMPI(vthread_t thr, vvp_code_t cp)
+{
+      vvp_signal_value*sig = dynamic_cast<vvp_signal_value*> (cp->net->fil);
+      assert(sig);
+
+      vvp_vector4_t lval;
+      sig->vec4_value(lval);
+
+      vvp_code_t imm = cp + 1;
+      vvp_vector4_t rval (imm->number, BIT4_0);
+      get_immediate_rval (imm, rval);
+
+      do_CMPE(thr, lval, rval);
+
+      thr->pc = cp + cp->bit_idx[0];
+}
+
+bool of_FUSE_LOAD_CMPIE(vthread_t thr, vvp_code_t cp)
+{
+      do_FUSE_LOAD_CMPI(thr, cp);
+      return true;
+}
+
+bool of_FUSE_LOAD_CMPINE(vthread_t thr, vvp_code_t cp)
+{
+      do_FUSE_LOAD_CMPI(thr, cp);
+
+      thr->flags[4] =  ~thr->flags[4];
+      thr->flags[6] =  ~thr->flags[6];
+      return true;
+}
+
+/*
+ * These are the fused forms of these sequences:
+ *
+ *    %load/vec4 <net>; %addi <vala>, <valb>, <wid>; %store/vec4 <net>, 0, <wid>
+ *    %load/vec4 <net>; %subi <vala>, <valb>, <wid>; %store/vec4 <net>, 0, <wid>
+ *
+ * The compiler only fuses these if <wid> is the width of the signal,
+ * so the result is sent to the signal as is.
+ */
+static void do_FUSE_LOAD_ADDI_STORE(vthread_t thr, vvp_code_t cp, bool sub_flag)
+{
+      vvp_signal_value*sig = dynamic_cast<vvp_signal_value*> (cp->net->fil);
+      assert(sig);
+
+      vvp_vector4_t val;
+      sig->vec4_value(val);
+
+      vvp_code_t imm = cp + 1;
+      vvp_vector4_t r (imm->number, BIT4_0);
+      get_immediate_rval (imm, r);
+
+      if (sub_flag)
+	    val.sub(r);
+      else
+	    val.add(r);
+
+      vvp_net_ptr_t ptr(cp->net, 0);
+      vvp_send_vec4(ptr, val, thr->wt_context);
+
+      thr->pc = cp + cp->bit_idx[0];
+}
+
+bool of_FUSE_LOAD_ADDI_STORE(vthread_t thr, vvp_code_t cp)
+{
+      do_FUSE_LOAD_ADDI_STORE(thr, cp, false);
+      return true;
+}
+
+bool of_FUSE_LOAD_SUBI_STORE(vthread_t thr, vvp_code_t cp)
+{
+      do_FUSE_LOAD_ADDI_STORE(thr, cp, true);
+      return true;
+}
+
 /*
  * %load/vec4a <arr>, <adrx>
  */
@@ -4448,13 +4739,14 @@ bool of_PARTI_U(vthread_t thr, vvp_code_t cp)
  */
 bool of_MUL(vthread_t thr, vvp_code_t)
 {
-      vvp_vector4_t r = thr->pop_vec4();
+      const vvp_vector4_t&r = thr->peek_vec4(0);
 	// Rather then pop l, use it directly from the stack. When we
-	// assign to 'l', that will edit the top of the stack, which
-	// replaces a pop and a pull.
-      vvp_vector4_t&l = thr->peek_vec4();
+	// assign to 'l', that will edit the stack in place, and
+	// popping r then leaves the result on the top.
+      vvp_vector4_t&l = thr->peek_vec4_under();
 
       l.mul(r);
+      thr->pop_vec4(1);
       return true;
 }
 
@@ -4491,8 +4783,8 @@ bool of_MUL_WR(vthread_t thr, vvp_code_t)
 
 bool of_NAND(vthread_t thr, vvp_code_t)
 {
-      vvp_vector4_t valr = thr->pop_vec4();
-      vvp_vector4_t&vall = thr->peek_vec4();
+      const vvp_vector4_t&valr = thr->peek_vec4(0);
+      vvp_vector4_t&vall = thr->peek_vec4_under();
       assert(vall.size() == valr.size());
       unsigned wid = vall.size();
 
@@ -4502,6 +4794,7 @@ bool of_NAND(vthread_t thr, vvp_code_t)
 	    vall.set_bit(idx, ~(lb&rb));
       }
 
+      thr->pop_vec4(1);
       return true;
 }
 
@@ -4744,9 +5037,10 @@ bool of_XNORR(vthread_t thr, vvp_code_t)
  */
 bool of_OR(vthread_t thr, vvp_code_t)
 {
-      vvp_vector4_t valb = thr->pop_vec4();
-      vvp_vector4_t&vala = thr->peek_vec4();
+      const vvp_vector4_t&valb = thr->peek_vec4(0);
+      vvp_vector4_t&vala = thr->peek_vec4_under();
       vala |= valb;
+      thr->pop_vec4(1);
       return true;
 }
 
@@ -4755,8 +5049,8 @@ bool of_OR(vthread_t thr, vvp_code_t)
  */
 bool of_NOR(vthread_t thr, vvp_code_t)
 {
-      vvp_vector4_t valr = thr->pop_vec4();
-      vvp_vector4_t&vall = thr->peek_vec4();
+      const vvp_vector4_t&valr = thr->peek_vec4(0);
+      vvp_vector4_t&vall = thr->peek_vec4_under();
       assert(vall.size() == valr.size());
       unsigned wid = vall.size();
 
@@ -4766,6 +5060,7 @@ bool of_NOR(vthread_t thr, vvp_code_t)
 	    vall.set_bit(idx, ~(lb|rb));
       }
 
+      thr->pop_vec4(1);
       return true;
 }
 
@@ -6310,10 +6605,11 @@ bool of_STORE_VEC4A(vthread_t thr, vvp_code_t cp)
  */
 bool of_SUB(vthread_t thr, vvp_code_t)
 {
-      vvp_vector4_t r = thr->pop_vec4();
-      vvp_vector4_t&l = thr->peek_vec4();
+      const vvp_vector4_t&r = thr->peek_vec4(0);
+      vvp_vector4_t&l = thr->peek_vec4_under();
 
       l.sub(r);
+      thr->pop_vec4(1);
       return true;
 }
 
@@ -6560,8 +6856,8 @@ bool of_WAIT_FORK(vthread_t thr, vvp_code_t)
  */
 bool of_XNOR(vthread_t thr, vvp_code_t)
 {
-      vvp_vector4_t valr = thr->pop_vec4();
-      vvp_vector4_t&vall = thr->peek_vec4();
+      const vvp_vector4_t&valr = thr->peek_vec4(0);
+      vvp_vector4_t&vall = thr->peek_vec4_under();
       assert(vall.size() == valr.size());
       unsigned wid = vall.size();
 
@@ -6572,6 +6868,7 @@ bool of_XNOR(vthread_t thr, vvp_code_t)
 	    vall.set_bit(idx, ~(lb ^ rb));
       }
 
+      thr->pop_vec4(1);
       return true;
 }
 
@@ -6580,8 +6877,8 @@ bool of_XNOR(vthread_t thr, vvp_code_t)
  */
 bool of_XOR(vthread_t thr, vvp_code_t)
 {
-      vvp_vector4_t valr = thr->pop_vec4();
-      vvp_vector4_t&vall = thr->peek_vec4();
+      const vvp_vector4_t&valr = thr->peek_vec4(0);
+      vvp_vector4_t&vall = thr->peek_vec4_under();
       assert(vall.size() == valr.size());
       unsigned wid = vall.size();
 
@@ -6592,6 +6889,7 @@ bool of_XOR(vthread_t thr, vvp_code_t)
 	    vall.set_bit(idx, lb ^ rb);
       }
 
+      thr->pop_vec4(1);
       return true;
 }
 
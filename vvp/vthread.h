@@ -70,6 +70,15 @@ extern void vthread_delay_delete();
  */
 extern void vthread_run(vthread_t thr);
 
+/*
+ * Select the loop that vthread_run uses to dispatch instructions. The
+ * threaded dispatch loop is the default where the compiler supports
+ * it (labels as values), otherwise this flag is ignored and every
+ * opcode is called through its function pointer.
+ */
+extern void vthread_set_threaded_dispatch(bool flag);
+extern bool vthread_get_threaded_dispatch(void);
+
 /*
  * This function schedules all the threads in the list to be scheduled
  * for execution with delay 0. The thr pointer is taken to be the head
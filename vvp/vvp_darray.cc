@@ -98,12 +98,20 @@ template <class TYPE> void vvp_darray_atom<TYPE>::get_word(unsigned adr, vvp_vec
 	    return;
       }
 
-      TYPE word = array_[adr];
-      vvp_vector4_t tmp (8*sizeof(TYPE), BIT4_0);
-      for (unsigned idx = 0 ; idx < tmp.size() ; idx += 1) {
-	    if (word&1) tmp.set_bit(idx, BIT4_1);
-	    word >>= 1;
+	// Pass the bits to the vector a word at a time. The word is
+	// shifted in two steps, because shifting by the full width of
+	// the value is undefined.
+      const unsigned long_bits = 8*sizeof(unsigned long);
+      unsigned long words[(8*sizeof(TYPE) + long_bits - 1) / long_bits];
+      uint64_t bits = static_cast<uint64_t>(array_[adr]);
+      for (unsigned idx = 0 ; idx < sizeof words / sizeof words[0] ; idx += 1) {
+	    words[idx] = bits;
+	    bits >>= long_bits/2;
+	    bits >>= long_bits/2;
       }
+
+      vvp_vector4_t tmp (8*sizeof(TYPE), BIT4_0);
+      tmp.setarray(0, tmp.size(), words);
       value = tmp;
 }
 
@@ -252,10 +260,7 @@ void vvp_darray_vec2::get_word(unsigned adr, vvp_vector4_t&value)
 	    return;
       }
       assert(array_[adr].size() == word_wid_);
-      value.resize(word_wid_);
-      for (unsigned idx = 0; idx < word_wid_; idx += 1) {
-	    value.set_bit(idx, array_[adr].value4(idx));
-      }
+      value = vector2_to_vector4(array_[adr], word_wid_);
 }
 
 void vvp_darray_vec2::shallow_copy(const vvp_object*obj)
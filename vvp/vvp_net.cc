@@ -33,6 +33,8 @@
 # include  <climits>
 # include  <cmath>
 # include  <cassert>
+# include  <vector>
+# include  <algorithm>
 #ifdef CHECK_WITH_VALGRIND
 # include  <valgrind/memcheck.h>
 # include  <map>
@@ -63,6 +65,8 @@ static size_t vvp_net_alloc_remaining = 0;
 // chunks allocated.
 unsigned long count_vvp_nets = 0;
 size_t size_vvp_nets = 0;
+// Keep the list of chunks so that the net graph can be walked.
+static vector<vvp_net_t*> vvp_net_chunks;
 
 void* vvp_net_t::operator new (size_t size)
 {
@@ -71,6 +75,7 @@ void* vvp_net_t::operator new (size_t size)
 	    vvp_net_alloc_table = ::new vvp_net_t[VVP_NET_CHUNK];
 	    vvp_net_alloc_remaining = VVP_NET_CHUNK;
 	    size_vvp_nets += size*VVP_NET_CHUNK;
+	    vvp_net_chunks.push_back(vvp_net_alloc_table);
 #ifdef CHECK_WITH_VALGRIND
 	    VALGRIND_MAKE_MEM_NOACCESS(vvp_net_alloc_table, size*VVP_NET_CHUNK);
 	    VALGRIND_CREATE_MEMPOOL(vvp_net_alloc_table, 0, 0);
@@ -93,6 +98,107 @@ void* vvp_net_t::operator new (size_t size)
       return return_this;
 }
 
+void vvp_net_list_all(vector<vvp_net_t*>&nets)
+{
+      nets.clear();
+      for (size_t idx = 0 ; idx < vvp_net_chunks.size() ; idx += 1) {
+	    size_t cnt = VVP_NET_CHUNK;
+	    if (idx+1 == vvp_net_chunks.size())
+		  cnt -= vvp_net_alloc_remaining;
+	    for (size_t jdx = 0 ; jdx < cnt ; jdx += 1)
+		  nets.push_back(vvp_net_chunks[idx] + jdx);
+      }
+}
+
+/*
+ * Find the independent regions of the net graph. Two nets are in the
+ * same region if one drives the other, either directly or through
+ * other nets, so a region is a connected component of the graph. A
+ * net that is not connected to any other net (a variable that only
+ * behavioral code uses, for example) is not counted as a region.
+ *
+ * This is an analysis only. It uses union-find over the allocation
+ * chunks and is reported in the statistics, to show how much of a
+ * design could be evaluated apart from the rest. The scheduler does
+ * not use it: the event queues, the event pools and the threads are
+ * shared by all the nets, so every region is still evaluated on the
+ * one simulation thread. Behavioral code may also touch nets from
+ * many regions, and is not taken into account.
+ */
+typedef pair<vvp_net_t*,size_t> net_chunk_base_t;
+
+static size_t net_partition_index_(const vector<net_chunk_base_t>&bases,
+				   vvp_net_t*net)
+{
+	// Find the last chunk that starts at or before the net. The
+	// chunks are sorted by address.
+      vector<net_chunk_base_t>::const_iterator cur
+	    = upper_bound(bases.begin(), bases.end(),
+			  net_chunk_base_t(net, SIZE_MAX));
+      if (cur == bases.begin())
+	    return SIZE_MAX;
+      --cur;
+      if ((size_t)(net - cur->first) >= VVP_NET_CHUNK)
+	    return SIZE_MAX;
+      return cur->second*VVP_NET_CHUNK + (net - cur->first);
+}
+
+static size_t net_partition_find_(vector<size_t>&parent, size_t idx)
+{
+      while (parent[idx] != idx) {
+	    parent[idx] = parent[parent[idx]];
+	    idx = parent[idx];
+      }
+      return idx;
+}
+
+void count_net_partitions(unsigned long&parts, unsigned long&largest)
+{
+      parts = 0;
+      largest = 0;
+      if (vvp_net_chunks.empty())
+	    return;
+
+      size_t nnets = (vvp_net_chunks.size()-1)*VVP_NET_CHUNK
+	    + (VVP_NET_CHUNK - vvp_net_alloc_remaining);
+
+      vector<net_chunk_base_t> bases (vvp_net_chunks.size());
+      for (size_t idx = 0 ; idx < vvp_net_chunks.size() ; idx += 1)
+	    bases[idx] = net_chunk_base_t(vvp_net_chunks[idx], idx);
+      sort(bases.begin(), bases.end());
+
+      vector<size_t> parent (nnets);
+      for (size_t idx = 0 ; idx < nnets ; idx += 1)
+	    parent[idx] = idx;
+
+      for (size_t idx = 0 ; idx < nnets ; idx += 1) {
+	    vvp_net_t*net = vvp_net_chunks[idx/VVP_NET_CHUNK] + idx%VVP_NET_CHUNK;
+	    for (vvp_net_ptr_t cur = net->out_ ; cur.ptr() != 0
+		       ; cur = cur.ptr()->port[cur.port()]) {
+		  size_t tgt = net_partition_index_(bases, cur.ptr());
+		    // Nets that are not from the chunks (if any) are
+		    // left out.
+		  if (tgt >= nnets)
+			continue;
+		  size_t a = net_partition_find_(parent, idx);
+		  size_t b = net_partition_find_(parent, tgt);
+		  if (a != b) parent[b] = a;
+	    }
+      }
+
+      vector<unsigned long> size (nnets);
+      for (size_t idx = 0 ; idx < nnets ; idx += 1)
+	    size[net_partition_find_(parent, idx)] += 1;
+
+      for (size_t idx = 0 ; idx < nnets ; idx += 1) {
+	    if (size[idx] < 2)
+		  continue;
+	    parts += 1;
+	    if (size[idx] > largest)
+		  largest = size[idx];
+      }
+}
+
 #ifdef CHECK_WITH_VALGRIND
 static map<vvp_net_t*, bool> vvp_net_map;
 static map<sfunc_core*, bool> sfunc_map;
@@ -590,6 +696,7 @@ void vvp_send_vec8(vvp_net_ptr_t ptr, const vvp_vector8_t&val)
 {
       while (vvp_net_t*cur = ptr.ptr()) {
 	    vvp_net_ptr_t next_val = cur->port[ptr.port()];
+	    VVP_PREFETCH_NET(next_val.ptr());
 
 	    if (cur->fun)
 		  cur->fun->recv_vec8(ptr, val);
@@ -602,6 +709,7 @@ void vvp_send_real(vvp_net_ptr_t ptr, double val, vvp_context_t context)
 {
       while (vvp_net_t*cur = ptr.ptr()) {
 	    vvp_net_ptr_t next_val = cur->port[ptr.port()];
+	    VVP_PREFETCH_NET(next_val.ptr());
 
 	    if (cur->fun)
 		  cur->fun->recv_real(ptr, val, context);
@@ -703,6 +811,22 @@ void vvp_vector4_t::copy_from_big_(const vvp_vector4_t&that)
       unsigned words = (size_+BITS_PER_WORD-1) / BITS_PER_WORD;
       abits_ptr_ = new unsigned long[2*words];
       bbits_ptr_ = abits_ptr_ + words;
+      count_vec4_heap_allocs += 1;
+
+      for (unsigned idx = 0 ;  idx < words ;  idx += 1)
+	    abits_ptr_[idx] = that.abits_ptr_[idx];
+      for (unsigned idx = 0 ;  idx < words ;  idx += 1)
+	    bbits_ptr_[idx] = that.bbits_ptr_[idx];
+}
+
+/*
+ * Copy the bits of that into the storage that this vector already
+ * has. The caller makes sure that both vectors are big, and that the
+ * storage is the right size.
+ */
+void vvp_vector4_t::copy_words_from_(const vvp_vector4_t&that)
+{
+      unsigned words = (size_+BITS_PER_WORD-1) / BITS_PER_WORD;
 
       for (unsigned idx = 0 ;  idx < words ;  idx += 1)
 	    abits_ptr_[idx] = that.abits_ptr_[idx];
@@ -722,6 +846,7 @@ void vvp_vector4_t::copy_inverted_from_(const vvp_vector4_t&that)
 	    unsigned words = (size_+BITS_PER_WORD-1) / BITS_PER_WORD;
 	    abits_ptr_ = new unsigned long[2*words];
 	    bbits_ptr_ = abits_ptr_ + words;
+	    count_vec4_heap_allocs += 1;
 
 	    unsigned remaining = size_;
 	    unsigned idx = 0;
@@ -752,6 +877,7 @@ void vvp_vector4_t::allocate_words_(unsigned long inita, unsigned long initb)
 	    unsigned cnt = (size_ + BITS_PER_WORD - 1) / BITS_PER_WORD;
 	    abits_ptr_ = new unsigned long[2*cnt];
 	    bbits_ptr_ = abits_ptr_ + cnt;
+	    count_vec4_heap_allocs += 1;
 	    for (unsigned idx = 0 ;  idx < cnt ;  idx += 1)
 		  abits_ptr_[idx] = inita;
 	    for (unsigned idx = 0 ;  idx < cnt ;  idx += 1)
@@ -1001,6 +1127,7 @@ void vvp_vector4_t::resize(unsigned newsize, vvp_bit4_t pad_bit)
 	    }
 
 	    unsigned long*newbits = new unsigned long[2*newcnt];
+	    count_vec4_heap_allocs += 1;
 
 	    if (cnt > 1) {
 		  unsigned trans = cnt;
@@ -1057,6 +1184,41 @@ void vvp_vector4_t::resize(unsigned newsize, vvp_bit4_t pad_bit)
 }
 
 
+bool vvp_vector4_t::getarray(unsigned wid, unsigned long*val) const
+{
+      unsigned words = (wid + BITS_PER_WORD - 1) / BITS_PER_WORD;
+      if (wid > size_)
+	    wid = size_;
+
+      unsigned long xz = 0;
+      for (unsigned idx = 0 ;  idx < words ;  idx += 1) {
+	    unsigned base = idx * BITS_PER_WORD;
+	    if (base >= wid) {
+		  val[idx] = 0;
+		  continue;
+	    }
+
+	    unsigned long atmp, btmp;
+	    if (size_ <= BITS_PER_WORD) {
+		  atmp = abits_val_;
+		  btmp = bbits_val_;
+	    } else {
+		  atmp = abits_ptr_[idx];
+		  btmp = bbits_ptr_[idx];
+	    }
+	    if (wid - base < BITS_PER_WORD) {
+		  unsigned long mask = (1UL << (wid - base)) - 1;
+		  atmp &= mask;
+		  btmp &= mask;
+	    }
+
+	    val[idx] = atmp & ~btmp;
+	    xz |= btmp;
+      }
+
+      return xz == 0;
+}
+
 unsigned long* vvp_vector4_t::subarray(unsigned adr, unsigned wid, bool xz_to_0) const
 {
       const unsigned BIT2_PER_WORD = 8*sizeof(unsigned long);
@@ -1135,6 +1297,69 @@ unsigned long* vvp_vector4_t::subarray(unsigned adr, unsigned wid, bool xz_to_0)
       return 0;
 }
 
+void vvp_vector4_t::vecval_to_planes_(unsigned size, const s_vpi_vecval*val,
+				      unsigned long*ap, unsigned long*bp)
+{
+      const unsigned per_word = BITS_PER_WORD / 32;
+      const unsigned nvec = (size + 31) / 32;
+      const unsigned words = (size + BITS_PER_WORD-1) / BITS_PER_WORD;
+
+      for (unsigned idx = 0 ; idx < words ; idx += 1) {
+	    unsigned long a = 0, b = 0;
+	    for (unsigned sub = 0 ; sub < per_word ; sub += 1) {
+		  unsigned vdx = idx*per_word + sub;
+		  if (vdx >= nvec)
+			break;
+		  a |= (unsigned long)(PLI_UINT32)val[vdx].aval << (32*sub);
+		  b |= (unsigned long)(PLI_UINT32)val[vdx].bval << (32*sub);
+	    }
+	    ap[idx] = a;
+	    bp[idx] = b;
+      }
+
+	// Clear any bits past the end of the vector.
+      if (unsigned top = size % BITS_PER_WORD) {
+	    unsigned long mask = (1UL << top) - 1UL;
+	    ap[words-1] &= mask;
+	    bp[words-1] &= mask;
+      }
+}
+
+void vvp_vector4_t::planes_to_vecval_(unsigned size, const unsigned long*ap,
+				      const unsigned long*bp, s_vpi_vecval*val)
+{
+      const unsigned per_word = BITS_PER_WORD / 32;
+      const unsigned nvec = (size + 31) / 32;
+
+      for (unsigned vdx = 0 ; vdx < nvec ; vdx += 1) {
+	    unsigned sh = 32 * (vdx % per_word);
+	    val[vdx].aval = (PLI_INT32)(ap[vdx/per_word] >> sh);
+	    val[vdx].bval = (PLI_INT32)(bp[vdx/per_word] >> sh);
+      }
+
+      if (unsigned top = size % 32) {
+	    PLI_UINT32 mask = (1U << top) - 1U;
+	    val[nvec-1].aval &= mask;
+	    val[nvec-1].bval &= mask;
+      }
+}
+
+void vvp_vector4_t::set_vecval(const s_vpi_vecval*val)
+{
+      if (size_ > BITS_PER_WORD)
+	    vecval_to_planes_(size_, val, abits_ptr_, bbits_ptr_);
+      else
+	    vecval_to_planes_(size_, val, &abits_val_, &bbits_val_);
+}
+
+void vvp_vector4_t::get_vecval(s_vpi_vecval*val) const
+{
+      if (size_ > BITS_PER_WORD)
+	    planes_to_vecval_(size_, abits_ptr_, bbits_ptr_, val);
+      else
+	    planes_to_vecval_(size_, &abits_val_, &bbits_val_, val);
+}
+
 void vvp_vector4_t::setarray(unsigned adr, unsigned wid, const unsigned long*val)
 {
       assert(adr+wid <= size_);
@@ -1825,6 +2050,24 @@ void vvp_vector4_t::change_z2x()
       }
 }
 
+void vvp_vector4_t::change_xz2zero()
+{
+	// The bbit of a BIT4_0 or BIT4_1 is 0 and the abit is the
+	// value, so clearing the abits where the bbit is set, and then
+	// all the bbits, makes the X and Z bits 0 and leaves the rest.
+
+      if (size_ <= BITS_PER_WORD) {
+	    abits_val_ &= ~bbits_val_;
+	    bbits_val_ = 0;
+      } else {
+	    unsigned words = (size_+BITS_PER_WORD-1) / BITS_PER_WORD;
+	    for (unsigned idx = 0 ;  idx < words ;  idx += 1) {
+		  abits_ptr_[idx] &= ~bbits_ptr_[idx];
+		  bbits_ptr_[idx] = 0;
+	    }
+      }
+}
+
 void vvp_vector4_t::fill_bits(vvp_bit4_t bit)
 {
 	/* note: this relies on the bit encoding for the vvp_bit4_t. */
@@ -2008,28 +2251,19 @@ ostream& operator<< (ostream&out, const vvp_vector4_t&that)
 template <class INT>bool vector4_to_value(const vvp_vector4_t&vec, INT&val,
 					  bool is_signed, bool is_arithmetic)
 {
-      INT res = 0;
-      INT msk = 1;
-      bool rc_flag = true;
+	// Get the bits a word at a time. An INT is at most 64 bits, so
+	// that is one or two words.
+      const unsigned long_bits = 8*sizeof(unsigned long);
+      unsigned long words[(8*sizeof(INT) + long_bits - 1) / long_bits];
+      const unsigned nwords = sizeof words / sizeof words[0];
 
-      unsigned size = vec.size();
-      if (size > 8*sizeof(val)) size = 8*sizeof(val);
-      for (unsigned idx = 0 ;  idx < size ;  idx += 1) {
-	    switch (vec.value(idx)) {
-		case BIT4_0:
-		  break;
-		case BIT4_1:
-		  res |= msk;
-		  break;
-		default:
-		  if (is_arithmetic)
-			return false;
-		  else
-			rc_flag = false;
-	    }
+      bool rc_flag = vec.getarray(8*sizeof(INT), words);
+      if (! rc_flag && is_arithmetic)
+	    return false;
 
-	    msk <<= 1;
-      }
+      INT res = static_cast<INT>(words[0]);
+      for (unsigned idx = 1 ;  idx < nwords ;  idx += 1)
+	    res |= static_cast<INT>(words[idx]) << (idx*long_bits);
 
       if (is_signed && vec.value(vec.size()-1) == BIT4_1) {
 	    if (vec.size() < 8*sizeof(val))
@@ -2168,6 +2402,25 @@ vvp_vector4array_t::~vvp_vector4array_t()
 {
 }
 
+void vvp_vector4array_t::set_vecvals(unsigned index, unsigned count,
+				     const s_vpi_vecval*vals)
+{
+      unsigned hwid = (width_ + 31) / 32;
+      vvp_vector4_t val (width_);
+      for (unsigned idx = 0 ; idx < count ; idx += 1) {
+	    val.set_vecval(vals + idx*hwid);
+	    set_word(index + idx, val);
+      }
+}
+
+void vvp_vector4array_t::get_vecvals(unsigned index, unsigned count,
+				     s_vpi_vecval*vals) const
+{
+      unsigned hwid = (width_ + 31) / 32;
+      for (unsigned idx = 0 ; idx < count ; idx += 1)
+	    get_word(index + idx).get_vecval(vals + idx*hwid);
+}
+
 void vvp_vector4array_t::set_word_(v4cell*cell, const vvp_vector4_t&that)
 {
       assert(that.size_ == width_);
@@ -2352,6 +2605,178 @@ vvp_vector4_t vvp_vector4array_aa::get_word(unsigned index) const
       return get_word_(cell);
 }
 
+vvp_vector4array_sp::vvp_vector4array_sp(unsigned width__, unsigned words__)
+: vvp_vector4array_t(width__, words__), pages_allocated_(0)
+{
+      cnt_ = (width_ + vvp_vector4_t::BITS_PER_WORD-1)/vvp_vector4_t::BITS_PER_WORD;
+      if (cnt_ == 0) cnt_ = 1;
+
+	// Size the pages so that each holds about 4096 unsigned longs
+	// in all, counting both the abits and the bbits, but at least
+	// 16 words.
+      page_shift_ = 4;
+      while ((cnt_ << (page_shift_+1)) <= 4096)
+	    page_shift_ += 1;
+
+      unsigned long npages = words_ >> page_shift_;
+      if (words_ & ((1U << page_shift_) - 1))
+	    npages += 1;
+      pages_.assign(npages, 0);
+}
+
+vvp_vector4array_sp::~vvp_vector4array_sp()
+{
+      for (size_t idx = 0 ; idx < pages_.size() ; idx += 1)
+	    delete[]pages_[idx];
+}
+
+/*
+ * Return a pointer to the abits of the word, or nil if the page that
+ * holds the word has never been written. The bbits follow the abits.
+ */
+inline unsigned long* vvp_vector4array_sp::page_word_(unsigned index) const
+{
+      unsigned long*page = pages_[index >> page_shift_];
+      if (page == 0)
+	    return 0;
+
+      unsigned off = index & ((1U << page_shift_) - 1);
+      return page + 2*cnt_*off;
+}
+
+/*
+ * Allocate the page that holds the word, with all its words set to
+ * X, and return a pointer to the abits of the word.
+ */
+unsigned long* vvp_vector4array_sp::alloc_page_(unsigned index)
+{
+      size_t page_len = (size_t)2*cnt_ << page_shift_;
+      unsigned long*page = new unsigned long[page_len];
+      for (size_t idx = 0 ; idx < page_len ; idx += 2*cnt_) {
+	    for (unsigned n = 0 ; n < cnt_ ; n += 1) {
+		  page[idx+n] = vvp_vector4_t::WORD_X_ABITS;
+		  page[idx+cnt_+n] = vvp_vector4_t::WORD_X_BBITS;
+	    }
+      }
+      pages_[index >> page_shift_] = page;
+      pages_allocated_ += 1;
+      return page_word_(index);
+}
+
+void vvp_vector4array_sp::set_word(unsigned index, const vvp_vector4_t&that)
+{
+      assert(index < words_);
+      assert(that.size_ == width_);
+
+      unsigned long*cell = page_word_(index);
+      if (cell == 0)
+	    cell = alloc_page_(index);
+
+      if (width_ <= vvp_vector4_t::BITS_PER_WORD) {
+	    cell[0] = that.abits_val_;
+	    cell[1] = that.bbits_val_;
+	    return;
+      }
+
+      memcpy(cell, that.abits_ptr_, cnt_*sizeof(unsigned long));
+      memcpy(cell+cnt_, that.bbits_ptr_, cnt_*sizeof(unsigned long));
+}
+
+vvp_vector4_t vvp_vector4array_sp::get_word(unsigned index) const
+{
+      if (index >= words_)
+	    return vvp_vector4_t(width_, BIT4_X);
+
+      const unsigned long*cell = page_word_(index);
+
+      if (width_ <= vvp_vector4_t::BITS_PER_WORD) {
+	    vvp_vector4_t res;
+	    res.size_ = width_;
+	    if (cell) {
+		  res.abits_val_ = cell[0];
+		  res.bbits_val_ = cell[1];
+	    } else {
+		  res.abits_val_ = vvp_vector4_t::WORD_X_ABITS;
+		  res.bbits_val_ = vvp_vector4_t::WORD_X_BBITS;
+	    }
+	    return res;
+      }
+
+      vvp_vector4_t res (width_, BIT4_X);
+      if (cell == 0)
+	    return res;
+
+      memcpy(res.abits_ptr_, cell, cnt_*sizeof(unsigned long));
+      memcpy(res.bbits_ptr_, cell+cnt_, cnt_*sizeof(unsigned long));
+
+      return res;
+}
+
+void vvp_vector4array_sp::set_vecvals(unsigned index, unsigned count,
+				      const s_vpi_vecval*vals)
+{
+      assert(index + count <= words_);
+
+      const unsigned hwid = (width_ + 31) / 32;
+      const unsigned page_mask = (1U << page_shift_) - 1;
+
+      while (count > 0) {
+	      // The words from index to the end of the page, or to
+	      // the end of the range, are contiguous in the page.
+	    unsigned run = (page_mask + 1) - (index & page_mask);
+	    if (run > count) run = count;
+
+	    unsigned long*cell = page_word_(index);
+	    if (cell == 0)
+		  cell = alloc_page_(index);
+
+	    for (unsigned idx = 0 ; idx < run ; idx += 1) {
+		  vvp_vector4_t::vecval_to_planes_(width_, vals, cell, cell+cnt_);
+		  cell += 2*cnt_;
+		  vals += hwid;
+	    }
+
+	    index += run;
+	    count -= run;
+      }
+}
+
+void vvp_vector4array_sp::get_vecvals(unsigned index, unsigned count,
+				      s_vpi_vecval*vals) const
+{
+      assert(index + count <= words_);
+
+      const unsigned hwid = (width_ + 31) / 32;
+      const unsigned page_mask = (1U << page_shift_) - 1;
+      const PLI_UINT32 top_mask = (width_ % 32) ? (1U << (width_ % 32)) - 1U : ~0U;
+
+      while (count > 0) {
+	    unsigned run = (page_mask + 1) - (index & page_mask);
+	    if (run > count) run = count;
+
+	    const unsigned long*cell = page_word_(index);
+	    if (cell == 0) {
+		    // The page was never written, so every word in
+		    // it reads as X.
+		  for (unsigned idx = 0 ; idx < run*hwid ; idx += 1) {
+			bool top = (idx % hwid) == hwid-1;
+			vals[idx].aval = top? top_mask : ~0U;
+			vals[idx].bval = top? top_mask : ~0U;
+		  }
+		  vals += run*hwid;
+	    } else {
+		  for (unsigned idx = 0 ; idx < run ; idx += 1) {
+			vvp_vector4_t::planes_to_vecval_(width_, cell, cell+cnt_, vals);
+			cell += 2*cnt_;
+			vals += hwid;
+		  }
+	    }
+
+	    index += run;
+	    count -= run;
+      }
+}
+
 vvp_vector2_t::vvp_vector2_t()
 {
       vec_ = 0;
@@ -2985,16 +3410,11 @@ bool operator == (const vvp_vector2_t&a, const vvp_vector2_t&b)
 
 vvp_vector4_t vector2_to_vector4(const vvp_vector2_t&that, unsigned wid)
 {
-      vvp_vector4_t res (wid);
-
-      for (unsigned idx = 0 ;  idx < res.size() ;  idx += 1) {
-	    vvp_bit4_t bit = BIT4_0;
-
-	    if (that.value(idx))
-		  bit = BIT4_1;
+      vvp_vector4_t res (wid, BIT4_0);
 
-	    res.set_bit(idx, bit);
-      }
+      unsigned cnt = that.wid_ < wid? that.wid_ : wid;
+      if (cnt > 0)
+	    res.setarray(0, cnt, that.vec_);
 
       return res;
 }
@@ -3088,15 +3508,25 @@ vvp_vector8_t::vvp_vector8_t(const vvp_vector4_t&that,
       if (size_ == 0)
 	    return;
 
+	// All the bits have the same strength, so there are only four
+	// possible scalar values. Make them once and look them up.
+      unsigned char map[4];
+      map[BIT4_0] = vvp_scalar_t(BIT4_0, str0, str1).raw();
+      map[BIT4_1] = vvp_scalar_t(BIT4_1, str0, str1).raw();
+      map[BIT4_X] = vvp_scalar_t(BIT4_X, str0, str1).raw();
+      map[BIT4_Z] = vvp_scalar_t(BIT4_Z, str0, str1).raw();
+
+      unsigned char*use_ptr;
       if (size_ <= sizeof(val_)) {
 	    ptr_ = 0; // Prefill all val_ bytes
-	    for (unsigned idx = 0 ; idx < size_ ; idx += 1)
-		  val_[idx] = vvp_scalar_t(that.value(idx),str0, str1).raw();
+	    use_ptr = val_;
       } else {
 	    ptr_ = new unsigned char[size_];
-	    for (unsigned idx = 0 ;  idx < size_ ;  idx += 1)
-		  ptr_[idx] = vvp_scalar_t(that.value(idx), str0, str1).raw();
+	    use_ptr = ptr_;
       }
+
+      for (unsigned idx = 0 ;  idx < size_ ;  idx += 1)
+	    use_ptr[idx] = map[that.value(idx)];
 }
 
 vvp_vector8_t::vvp_vector8_t(const vvp_vector2_t&that,
@@ -3171,8 +3601,13 @@ vvp_vector8_t vvp_vector8_t::subvalue(unsigned base, unsigned wid) const
 void vvp_vector8_t::set_vec(unsigned base, const vvp_vector8_t&that)
 {
       assert((base+that.size()) <= size());
-      for (unsigned idx = 0 ; idx < that.size() ; idx += 1)
-	    set_bit(base+idx, that.value(idx));
+      if (that.size_ == 0)
+	    return;
+
+      unsigned char*use_ptr = size_ <= sizeof(val_) ? val_ : ptr_;
+      const unsigned char*that_ptr = that.size_ <= sizeof(that.val_) ?
+                                     that.val_ : that.ptr_;
+      memcpy(use_ptr+base, that_ptr, that.size_);
 }
 
 vvp_vector8_t part_expand(const vvp_vector8_t&that, unsigned wid, unsigned off)
@@ -3195,6 +3630,113 @@ vvp_vector8_t part_expand(const vvp_vector8_t&that, unsigned wid, unsigned off)
       return tmp;
 }
 
+/*
+ * The resolve of vvp_vector8_t vectors works on the scalar bytes a
+ * word at a time. Most bit pairs are resolved by one of the simple
+ * rules: one of the values is HiZ, the values are the same, or both
+ * values are unambiguous so that the stronger wins (or the value
+ * becomes X if the strengths are equal). The word operations handle
+ * all these cases for all the bytes in the word at once, and only
+ * the bytes that remain go through the fully featured resolver.
+ */
+static const uint64_t RESOLV_BYTES_01 = UINT64_C(0x0101010101010101);
+
+  // Given a word with the high bit of each byte set or clear, return
+  // a word with each byte all 1s or all 0s to match.
+static inline uint64_t resolv_byte_mask(uint64_t high_bits)
+{
+      return (high_bits >> 7) * 0xff;
+}
+
+  // Return the high bit of each byte set if the byte is not zero.
+static inline uint64_t resolv_nonzero(uint64_t word)
+{
+      const uint64_t low7 = RESOLV_BYTES_01 * 0x7f;
+      return (((word & low7) + low7) | word) & (RESOLV_BYTES_01 * 0x80);
+}
+
+extern vvp_scalar_t fully_featured_resolv_(vvp_scalar_t, vvp_scalar_t);
+
+static uint64_t resolve_word(uint64_t a, uint64_t b, uint64_t&need)
+{
+      const uint64_t str_bits = RESOLV_BYTES_01 * 0x77;
+      const uint64_t nib_bits = RESOLV_BYTES_01 * 0x0f;
+      const uint64_t high_bits= RESOLV_BYTES_01 * 0x80;
+
+      uint64_t a_hiz = ~resolv_byte_mask(resolv_nonzero(a & str_bits));
+      uint64_t b_hiz = ~resolv_byte_mask(resolv_nonzero(b & str_bits));
+      uint64_t same  = ~resolv_byte_mask(resolv_nonzero(a ^ b));
+
+	// These bytes are taken from b, and the remaining bytes from a
+	// unless they are resolved below.
+      uint64_t take_b = a_hiz;
+      uint64_t done = a_hiz | b_hiz | same;
+
+	// A byte is unambiguous if the 0 and 1 strength/value nibbles
+	// are the same.
+      uint64_t a_unamb = ~resolv_byte_mask(resolv_nonzero(((a>>4) ^ a) & nib_bits));
+      uint64_t b_unamb = ~resolv_byte_mask(resolv_nonzero(((b>>4) ^ b) & nib_bits));
+      uint64_t unamb = a_unamb & b_unamb & ~done;
+
+	// For unambiguous values compare the strengths. The high bit
+	// of each byte is set if the strength of a is at least the
+	// strength of b.
+      const uint64_t low3 = RESOLV_BYTES_01 * 0x07;
+      uint64_t a_ge_b = resolv_byte_mask((((a & low3) | high_bits) - (b & low3))
+					 & high_bits);
+      uint64_t same_str = ~resolv_byte_mask(resolv_nonzero((a ^ b) & str_bits));
+
+      take_b |= unamb & ~a_ge_b;
+      uint64_t make_x = unamb & same_str;
+
+      uint64_t out = (a & ~take_b) | (b & take_b);
+      out = (out & ~make_x) | (((a & str_bits) | high_bits) & make_x);
+
+      need = ~(done | unamb);
+      return out;
+}
+
+vvp_vector8_t resolve(const vvp_vector8_t&a, const vvp_vector8_t&b)
+{
+      assert(a.size() == b.size());
+      unsigned size = a.size();
+      vvp_vector8_t out (size);
+      if (size == 0)
+	    return out;
+
+      const unsigned char*a_ptr = size <= sizeof(a.val_)? a.val_ : a.ptr_;
+      const unsigned char*b_ptr = size <= sizeof(b.val_)? b.val_ : b.ptr_;
+      unsigned char*o_ptr = size <= sizeof(out.val_)? out.val_ : out.ptr_;
+
+      for (unsigned base = 0 ;  base < size ;  base += sizeof(uint64_t)) {
+	    unsigned cnt = size - base;
+	    if (cnt > sizeof(uint64_t))
+		  cnt = sizeof(uint64_t);
+
+	    uint64_t aw = 0, bw = 0, need;
+	    memcpy(&aw, a_ptr+base, cnt);
+	    memcpy(&bw, b_ptr+base, cnt);
+	    uint64_t ow = resolve_word(aw, bw, need);
+	    memcpy(o_ptr+base, &ow, cnt);
+
+	      // Resolve whatever is left one bit at a time. The unused
+	      // bytes at the end of a partial word are HiZ, so they
+	      // never need this.
+	    if (need == 0)
+		  continue;
+	    const unsigned char*need_ptr = reinterpret_cast<unsigned char*>(&need);
+	    for (unsigned idx = 0 ;  idx < cnt ;  idx += 1) {
+		  if (need_ptr[idx] == 0)
+			continue;
+		  out.set_bit(base+idx,
+			      fully_featured_resolv_(a.value(base+idx),
+						     b.value(base+idx)));
+	    }
+      }
+
+      return out;
+}
+
 static bool c8string_header_test(const char*str)
 {
       if ((str[0] != 'C') && (str[0] != 'c'))
@@ -3365,6 +3907,11 @@ void vvp_net_fun_t::force_flag(bool)
 {
 }
 
+vvp_gen_event_s* vvp_net_fun_t::cone_event()
+{
+      return 0;
+}
+
 /* **** vvp_fun_drive methods **** */
 
 vvp_fun_drive::vvp_fun_drive(unsigned str0, unsigned str1)
@@ -28,6 +28,7 @@
 # include  <cstdlib>
 # include  <cstring>
 # include  <string>
+# include  <vector>
 # include  <new>
 # include  <cassert>
 
@@ -57,6 +58,8 @@ class  vvp_fun_part;
 
 class  vvp_delay_t;
 
+struct vvp_gen_event_s;
+
 /*
  * Storage for items declared in automatically allocated scopes (i.e. automatic
  * tasks and functions). The first two slots in each context are reserved for
@@ -243,6 +246,7 @@ class vvp_vector4_t {
       friend class vvp_vector4array_t;
       friend class vvp_vector4array_sa;
       friend class vvp_vector4array_aa;
+      friend class vvp_vector4array_sp;
 
     public:
       static const vvp_vector4_t nil;
@@ -264,6 +268,11 @@ class vvp_vector4_t {
       vvp_vector4_t(const vvp_vector4_t&that, bool invert_flag);
       vvp_vector4_t& operator= (const vvp_vector4_t&that);
 
+	// Moving a vector takes its heap storage (if any) and leaves
+	// the source as a zero width vector.
+      vvp_vector4_t(vvp_vector4_t&&that) noexcept;
+      vvp_vector4_t& operator= (vvp_vector4_t&&that) noexcept;
+
       ~vvp_vector4_t();
 
       inline unsigned size() const { return size_; }
@@ -278,6 +287,14 @@ class vvp_vector4_t {
 	// in the array.
       unsigned long*subarray(unsigned idx, unsigned size, bool xz_to_0 =false) const;
       void setarray(unsigned idx, unsigned size, const unsigned long*val);
+	// Copy the low size bits into the val words as 2-value bits,
+	// a word at a time. X and Z bits are copied as 0, and the
+	// result is false if there were any.
+      bool getarray(unsigned size, unsigned long*val) const;
+	// Copy the whole vector from or to VPI vecval words, 32 bits
+	// per word. The VPI aval/bval encoding is the same as ours.
+      void set_vecval(const s_vpi_vecval*val);
+      void get_vecval(s_vpi_vecval*val) const;
 
 	// Set a 4-value bit or subvector into the vector. Return true
 	// if any bits of the vector change as a result of this operation.
@@ -311,6 +328,9 @@ class vvp_vector4_t {
 	// Change all Z bits to X bits.
       void change_z2x();
 
+	// Change all X and Z bits to 0 bits.
+      void change_xz2zero();
+
 	// Set all bits to the specified value.
       void fill_bits(vvp_bit4_t bit);
 
@@ -348,10 +368,20 @@ class vvp_vector4_t {
 #error "WORD_X_xBITS not defined for this architecture?"
 #endif
 
+	// The set_vecval and get_vecval methods use these to convert
+	// between VPI vecval words and the abits/bbits planes of a
+	// vector of the given size.
+      static void vecval_to_planes_(unsigned size, const s_vpi_vecval*val,
+				    unsigned long*ap, unsigned long*bp);
+      static void planes_to_vecval_(unsigned size, const unsigned long*ap,
+				    const unsigned long*bp, s_vpi_vecval*val);
+
 	// Initialize and operator= use this private method to copy
 	// the data from that object into this object.
       void copy_from_(const vvp_vector4_t&that);
       void copy_from_big_(const vvp_vector4_t&that);
+      void copy_words_from_(const vvp_vector4_t&that);
+      void take_from_(vvp_vector4_t&that);
       void copy_inverted_from_(const vvp_vector4_t&that);
 
       void allocate_words_(unsigned long inita, unsigned long initb);
@@ -418,19 +448,60 @@ inline vvp_vector4_t::~vvp_vector4_t()
       }
 }
 
+inline vvp_vector4_t::vvp_vector4_t(vvp_vector4_t&&that) noexcept
+{
+      take_from_(that);
+}
+
 inline vvp_vector4_t& vvp_vector4_t::operator= (const vvp_vector4_t&that)
 {
       if (this == &that)
 	    return *this;
 
-      if (size_ > BITS_PER_WORD)
+      if (size_ > BITS_PER_WORD) {
+	      // If the new value needs the same number of words as
+	      // the storage that I already have, then copy into it
+	      // instead of allocating new storage.
+	    if (that.size_ > BITS_PER_WORD
+		&& (size_-1)/BITS_PER_WORD == (that.size_-1)/BITS_PER_WORD) {
+		  size_ = that.size_;
+		  copy_words_from_(that);
+		  return *this;
+	    }
 	    delete[] abits_ptr_;
+      }
 
       copy_from_(that);
 
       return *this;
 }
 
+inline vvp_vector4_t& vvp_vector4_t::operator= (vvp_vector4_t&&that) noexcept
+{
+      if (this == &that)
+	    return *this;
+
+      if (size_ > BITS_PER_WORD)
+	    delete[] abits_ptr_;
+
+      take_from_(that);
+
+      return *this;
+}
+
+inline void vvp_vector4_t::take_from_(vvp_vector4_t&that)
+{
+      size_ = that.size_;
+      if (size_ <= BITS_PER_WORD) {
+	    abits_val_ = that.abits_val_;
+	    bbits_val_ = that.bbits_val_;
+      } else {
+	    abits_ptr_ = that.abits_ptr_;
+	    bbits_ptr_ = that.bbits_ptr_;
+	    that.size_ = 0;
+      }
+}
+
 inline void vvp_vector4_t::copy_from_(const vvp_vector4_t&that)
 {
       size_ = that.size_;
@@ -588,6 +659,13 @@ class vvp_vector4array_t {
       virtual vvp_vector4_t get_word(unsigned idx) const = 0;
       virtual void set_word(unsigned idx, const vvp_vector4_t&that) = 0;
 
+	// Copy count consecutive words, starting at idx, from or to
+	// VPI vecval format. Each word takes (width+31)/32 vecvals.
+	// These work a word at a time unless the storage has a
+	// better way.
+      virtual void set_vecvals(unsigned idx, unsigned count, const s_vpi_vecval*vals);
+      virtual void get_vecvals(unsigned idx, unsigned count, s_vpi_vecval*vals) const;
+
     protected:
       struct v4cell {
 	    union {
@@ -627,6 +705,41 @@ class vvp_vector4array_sa : public vvp_vector4array_t {
       v4cell* array_;
 };
 
+/*
+ * Sparse vvp_vector4array_t for very large memories. The words are
+ * grouped into pages, and a page is only allocated (filled with X)
+ * the first time one of its words is written. The words of a page
+ * are packed one after the other, each as the abits followed by the
+ * bbits, so wide words do not need a heap allocation each.
+ */
+class vvp_vector4array_sp : public vvp_vector4array_t {
+
+    public:
+      vvp_vector4array_sp(unsigned width, unsigned words);
+      ~vvp_vector4array_sp();
+
+      vvp_vector4_t get_word(unsigned idx) const;
+      void set_word(unsigned idx, const vvp_vector4_t&that);
+
+	// Work through the words a page at a time. Reading does not
+	// allocate pages that were never written.
+      void set_vecvals(unsigned idx, unsigned count, const s_vpi_vecval*vals);
+      void get_vecvals(unsigned idx, unsigned count, s_vpi_vecval*vals) const;
+
+	// Number of pages that have been written so far.
+      unsigned long pages_allocated() const { return pages_allocated_; }
+
+    private:
+      unsigned long*page_word_(unsigned idx) const;
+      unsigned long*alloc_page_(unsigned idx);
+
+	// Number of unsigned longs in each plane of a word.
+      unsigned cnt_;
+      unsigned page_shift_;
+      unsigned long pages_allocated_;
+      std::vector<unsigned long*> pages_;
+};
+
 /*
  * Automatically allocated vvp_vector4array_t
  */
@@ -658,6 +771,7 @@ class vvp_vector2_t {
 				       const vvp_vector2_t&);
       friend vvp_vector2_t operator * (const vvp_vector2_t&,
 				       const vvp_vector2_t&);
+      friend vvp_vector4_t vector2_to_vector4(const vvp_vector2_t&, unsigned);
       friend bool operator >  (const vvp_vector2_t&, const vvp_vector2_t&);
       friend bool operator >= (const vvp_vector2_t&, const vvp_vector2_t&);
       friend bool operator <  (const vvp_vector2_t&, const vvp_vector2_t&);
@@ -908,6 +1022,7 @@ extern std::ostream& operator<< (std::ostream&, vvp_scalar_t);
 class vvp_vector8_t {
 
       friend vvp_vector8_t part_expand(const vvp_vector8_t&, unsigned, unsigned);
+      friend vvp_vector8_t resolve(const vvp_vector8_t&, const vvp_vector8_t&);
 
     public:
       explicit vvp_vector8_t(unsigned size =0);
@@ -947,18 +1062,9 @@ class vvp_vector8_t {
 };
 
   /* Resolve uses the default Verilog resolver algorithm to resolve
-     two drive vectors to a single output. */
-inline vvp_vector8_t resolve(const vvp_vector8_t&a, const vvp_vector8_t&b)
-{
-      assert(a.size() == b.size());
-      vvp_vector8_t out (a.size());
-
-      for (unsigned idx = 0 ;  idx < out.size() ;  idx += 1) {
-	    out.set_bit(idx, resolve(a.value(idx), b.value(idx)));
-      }
-
-      return out;
-}
+     two drive vectors to a single output. The common cases are
+     resolved a word (several bits) at a time. */
+extern vvp_vector8_t resolve(const vvp_vector8_t&a, const vvp_vector8_t&b);
 
   /* This lookup tabke implements the strength reduction implied by
      Verilog standard switch devices. The major dimension selects
@@ -1114,6 +1220,14 @@ template <class T> std::ostream& operator << (std::ostream&out, vvp_sub_pointer_
  * all the fan-out chain, delivering the specified value. The send_*()
  * methods of the vvp_net_t class are similar, but they follow the
  * output, possibly filtered, from the vvp_net_t.
+ *
+ * The nets of a fan-out chain are scattered in memory, and the next
+ * net is only known once the current one is loaded, so walking a long
+ * chain is a series of cache misses. The vvp_send_*() functions start
+ * loading the next net of the chain before they deliver the value to
+ * the current one, so that the two overlap. The next pointer shares
+ * the cache line of the vvp_net_t with the fun pointer, which has to
+ * be loaded anyway, so the chain itself costs no extra memory traffic.
  */
 class vvp_net_t {
     public:
@@ -1172,6 +1286,12 @@ class vvp_net_t {
 #endif
 };
 
+/*
+ * Get all the vvp_net_t objects allocated so far. This is for
+ * analyses of the whole net graph when the design is loaded.
+ */
+extern void vvp_net_list_all(std::vector<vvp_net_t*>&nets);
+
 /*
  * Instances of this class represent the functionality of a
  * node. vvp_net_t objects hold pointers to the vvp_net_fun_t
@@ -1233,6 +1353,12 @@ class vvp_net_fun_t {
 	// do something about it.
       virtual void force_flag(bool run_now);
 
+	// Functors that evaluate their inputs in an event of their own,
+	// with no delay, return that event here so that they can be
+	// gathered into combinational cones (see cone.h). The event
+	// must send its result through the net that scheduled it.
+      virtual vvp_gen_event_s* cone_event();
+
    protected:
       void recv_vec4_pv_(vvp_net_ptr_t p, const vvp_vector4_t&bit,
 			 unsigned base, unsigned vwid, vvp_context_t context);
@@ -1520,10 +1646,18 @@ class vvp_wide_fun_t : public vvp_net_fun_t {
 };
 
 
+/* Start loading the next net of a fan-out chain. (See vvp_net_t.) */
+#if defined(__GNUC__)
+# define VVP_PREFETCH_NET(net) __builtin_prefetch(net)
+#else
+# define VVP_PREFETCH_NET(net) do { } while (0)
+#endif
+
 inline void vvp_send_vec4(vvp_net_ptr_t ptr, const vvp_vector4_t&val, vvp_context_t context)
 {
       while (class vvp_net_t*cur = ptr.ptr()) {
 	    vvp_net_ptr_t next_val = cur->port[ptr.port()];
+	    VVP_PREFETCH_NET(next_val.ptr());
 
 	    if (cur->fun)
 		  cur->fun->recv_vec4(ptr, val, context);
@@ -1540,6 +1674,7 @@ inline void vvp_send_string(vvp_net_ptr_t ptr, const std::string&val, vvp_contex
 {
       while (vvp_net_t*cur = ptr.ptr()) {
 	    vvp_net_ptr_t next_val = cur->port[ptr.port()];
+	    VVP_PREFETCH_NET(next_val.ptr());
 
 	    if (cur->fun)
 		  cur->fun->recv_string(ptr, val, context);
@@ -1552,6 +1687,7 @@ inline void vvp_send_object(vvp_net_ptr_t ptr, vvp_object_t val, vvp_context_t c
 {
       while (vvp_net_t*cur = ptr.ptr()) {
 	    vvp_net_ptr_t next_val = cur->port[ptr.port()];
+	    VVP_PREFETCH_NET(next_val.ptr());
 
 	    if (cur->fun)
 		  cur->fun->recv_object(ptr, val, context);
@@ -1584,6 +1720,7 @@ inline void vvp_send_vec4_pv(vvp_net_ptr_t ptr, const vvp_vector4_t&val,
 {
       while (class vvp_net_t*cur = ptr.ptr()) {
 	    vvp_net_ptr_t next_val = cur->port[ptr.port()];
+	    VVP_PREFETCH_NET(next_val.ptr());
 
 	    if (cur->fun)
 		  cur->fun->recv_vec4_pv(ptr, val, base, vwid, context);
@@ -1597,6 +1734,7 @@ inline void vvp_send_vec8_pv(vvp_net_ptr_t ptr, const vvp_vector8_t&val,
 {
       while (class vvp_net_t*cur = ptr.ptr()) {
 	    vvp_net_ptr_t next_val = cur->port[ptr.port()];
+	    VVP_PREFETCH_NET(next_val.ptr());
 
 	    if (cur->fun)
 		  cur->fun->recv_vec8_pv(ptr, val, base, vwid);
@@ -67,14 +67,14 @@ template <class T> vvp_net_fil_t::prop_t vvp_net_fil_t::filter_mask_(const T&val
 	    }
 
 	    if (propagate_flag) {
-		  run_vpi_callbacks();
+		  run_vpi_callbacks(base, val.size());
 		  return REPL;
 	    } else {
 		  return STOP;
 	    }
 
       } else {
-	    run_vpi_callbacks();
+	    run_vpi_callbacks(base, val.size());
 	    return PROP;
       }
 }
@@ -997,7 +997,7 @@ void vvp_wire_vec4::release_pv(vvp_net_ptr_t ptr, unsigned base, unsigned wid, b
 	    needs_init_ = ! force4_.subvalue(base,wid) .eeq(bits4_.subvalue(base,wid));
 	    ptr.ptr()->send_vec4_pv(bits4_.subvalue(base,wid),
 				    base, bits4_.size(), 0);
-	    run_vpi_callbacks();
+	    run_vpi_callbacks(base, wid);
       } else {
 	      // Variables keep the current value.
 	    vvp_vector4_t res (wid);
@@ -1051,6 +1051,33 @@ bool vvp_wire_vec4::is_forced(unsigned idx) const
       return test_force_mask(idx);
 }
 
+vvp_wire_vec2::vvp_wire_vec2(unsigned wid)
+: vvp_wire_vec4(wid, BIT4_0)
+{
+}
+
+vvp_net_fil_t::prop_t vvp_wire_vec2::filter_vec4(const vvp_vector4_t&bit, vvp_vector4_t&rep,
+						 unsigned base, unsigned vwid)
+{
+	// The zero width vector stands for all X bits (see the
+	// vvp_wire_vec4 filter), which here are all 0 bits.
+      if (base==0 && vwid==0) {
+	    vvp_vector4_t tmp (value_size(), BIT4_0);
+	    prop_t rc = vvp_wire_vec4::filter_vec4(tmp, rep, 0, tmp.size());
+	    if (rc == PROP) rep = tmp;
+	    return rc==STOP? STOP : REPL;
+      }
+
+      if (! bit.has_xz())
+	    return vvp_wire_vec4::filter_vec4(bit, rep, base, vwid);
+
+      vvp_vector4_t tmp (bit);
+      tmp.change_xz2zero();
+      prop_t rc = vvp_wire_vec4::filter_vec4(tmp, rep, base, vwid);
+      if (rc == PROP) rep = tmp;
+      return rc==STOP? STOP : REPL;
+}
+
 vvp_wire_vec8::vvp_wire_vec8(unsigned wid)
 : bits8_(wid)
 {
@@ -1163,7 +1190,7 @@ void vvp_wire_vec8::release_pv(vvp_net_ptr_t ptr, unsigned base, unsigned wid, b
 	    needs_init_ = !force8_.subvalue(base,wid) .eeq((bits8_.subvalue(base,wid)));
 	    ptr.ptr()->send_vec8_pv(bits8_.subvalue(base,wid),
 				    base, bits8_.size());
-	    run_vpi_callbacks();
+	    run_vpi_callbacks(base, wid);
       } else {
 	// Variable do not know about strength so this should not be able
 	// to happen. If for some reason it can then it should not be too
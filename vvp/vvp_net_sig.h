@@ -455,6 +455,21 @@ class vvp_wire_vec4 : public vvp_wire_base {
       vvp_vector4_t force4_; // the value being forced
 };
 
+/*
+ * The vvp_wire_vec2 is the filter for the 2-state variables and nets
+ * of a design compiled in two-state mode. The code generator does not
+ * cast the values stored into these signals to 2-state, so the filter
+ * changes any X or Z bits that arrive to 0.
+ */
+class vvp_wire_vec2 : public vvp_wire_vec4 {
+
+    public:
+      explicit vvp_wire_vec2(unsigned wid);
+
+      prop_t filter_vec4(const vvp_vector4_t&bit, vvp_vector4_t&rep,
+			 unsigned base, unsigned vwid);
+};
+
 class vvp_wire_vec8 : public vvp_wire_base {
 
     public:
@@ -40,7 +40,11 @@ class vvp_vpi_callback {
 
       void attach_as_word(struct __vpiArray* arr, unsigned long addr);
 
-      void add_vpi_callback(value_callback*);
+	// Attach a value change callback. The lsb and msb are the
+	// canonical bit range of the value that the callback watches;
+	// changes that do not touch those bits do not trigger it.
+      void add_vpi_callback(value_callback*cb,
+                            unsigned lsb =0, unsigned msb =~0U);
 #ifdef CHECK_WITH_VALGRIND
 	/* This has only been tested at EOS. */
       void clear_all_callbacks(void);
@@ -52,11 +56,12 @@ class vvp_vpi_callback {
 
     protected:
 	// Derived classes call this method to indicate that it is
-	// time to call the callback.
-      void run_vpi_callbacks();
+	// time to call the callback. The base and wid describe the
+	// canonical bits that may have changed, if that is known.
+      void run_vpi_callbacks(unsigned base =0, unsigned wid =~0U);
 
     private:
-      value_callback*vpi_callbacks_;
+      struct __vpi_callback_list*vpi_callbacks_;
       struct __vpi_array_word*array_words_;
 };
 
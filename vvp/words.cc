@@ -164,6 +164,26 @@ void compile_var_cobject(char*label, char*name)
       delete[] name;
 }
 
+/*
+ * Set by the :ivl_two_state header of a design compiled in two-state
+ * mode. The 2-state variables and nets of such a design then get a
+ * filter that changes X and Z values to 0.
+ */
+static bool two_state_flag = false;
+
+void compile_two_state(void)
+{
+      two_state_flag = true;
+}
+
+static vvp_wire_vec4* new_wire_int2(unsigned wid)
+{
+      if (two_state_flag)
+	    return new vvp_wire_vec2(wid);
+      else
+	    return new vvp_wire_vec4(wid, BIT4_0);
+}
+
 /*
  * A variable is a special functor, so we allocate that functor and
  * write the label into the symbol table.
@@ -187,7 +207,10 @@ void compile_variable(char*label, char*name,
 	    net->fil = tmp;
             net->fun = tmp;
       } else {
-	    net->fil = new vvp_wire_vec4(wid, init);
+	    if (vpi_type_code == vpiIntVar)
+		  net->fil = new_wire_int2(wid);
+	    else
+		  net->fil = new vvp_wire_vec4(wid, init);
             net->fun = new vvp_fun_signal4_sa(wid);
       }
       vvp_signal_value*vfil = dynamic_cast<vvp_signal_value*>(net->fil);
@@ -331,7 +354,7 @@ static void do_compile_net(vvp_net_t*node, vvp_array_t array,
       if (vsig == 0) {
 	    switch (vpi_type_code) {
 		case vpiIntVar:
-		  vsig = new vvp_wire_vec4(wid,BIT4_0);
+		  vsig = new_wire_int2(wid);
 		  break;
 		case vpiLogicVar:
 		  vsig = new vvp_wire_vec4(wid,BIT4_Z);